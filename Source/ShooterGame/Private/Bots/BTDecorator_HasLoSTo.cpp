@@ -61,7 +61,7 @@ bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(class UBehaviorTreeCompon
 bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
 	const UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
-	AAIController* MyController = OwnerComp.GetAIOwner();
+	AShooterAIController* MyController = Cast<AShooterAIController>(OwnerComp.GetAIOwner());
 	bool HasLOS = false;
 
 	if (MyController && MyBlackboard)
@@ -90,7 +90,8 @@ bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(UBehaviorTreeComponent& O
 
 		if (bGotTarget== true )
 		{
-			if (LOSTrace(OwnerComp.GetOwner(), EnemyActor, TargetLocation) == true)
+			// last known result, trace is done asynchronously by controller
+			if (MyController->GetCachedLOS(EnemyActor, TargetLocation, true) == true)
 			{
 				HasLOS = true;
 			}
@@ -100,72 +101,6 @@ bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(UBehaviorTreeComponent& O
 	return HasLOS;
 }
 
-bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, const FVector& EndLocation) const
-{
-	AShooterAIController* MyController = Cast<AShooterAIController>(InActor);
-	AShooterBot* MyBot = MyController ? Cast<AShooterBot>(MyController->GetPawn()) : NULL; 
-
-	bool bHasLOS = false;
-	{
-		if (MyBot != NULL)
-		{
-			// Perform trace to retrieve hit info
-			FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AILosTrace), true, InActor);
-			
-			TraceParams.bReturnPhysicalMaterial = true;
-			TraceParams.AddIgnoredActor(MyBot);
-			const FVector StartLocation = MyBot->GetActorLocation();
-			FHitResult Hit(ForceInit);
-			GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-			if (Hit.bBlockingHit == true)
-			{
-				// We hit something. If we have an actor supplied, just check if the hit actor is an enemy. If it is consider that 'has LOS'
-				AActor* HitActor = Hit.GetActor();
-				if (Hit.GetActor() != NULL)
-				{
-					// If the hit is our target actor consider it LOS
-					if (HitActor == InActor)
-					{
-						bHasLOS = true;
-					}
-					else
-					{
-						// Check the team of us against the team of the actor we hit if we are able. If they dont match good to go.
-						ACharacter* HitChar = Cast<ACharacter>(HitActor);
-						if ( (HitChar != NULL)
-							&& (MyController->PlayerState != NULL) && (HitChar->GetPlayerState() != NULL))
-						{
-							AShooterPlayerState* HitPlayerState = Cast<AShooterPlayerState>(HitChar->GetPlayerState());
-							AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyController->PlayerState);
-							if ((HitPlayerState != NULL) && (MyPlayerState != NULL))
-							{
-								if (HitPlayerState->GetTeamNum() != MyPlayerState->GetTeamNum())
-								{
-									bHasLOS = true;
-								}
-							}
-						}
-					}
-				}
-				else //we didnt hit an actor
-				{
-					if (InEnemyActor == NULL)
-					{
-						// We were not given an actor - so check of the distance between what we hit and the target. If what we hit is further away than the target we should be able to hit our target.
-						FVector HitDelta = Hit.ImpactPoint - StartLocation;
-						FVector TargetDelta = EndLocation - StartLocation;
-						if (TargetDelta.SizeSquared() < HitDelta.SizeSquared())
-						{
-							bHasLOS = true;
-						}
-					}
-				}
-			}
-		}
-	}
-
-	return bHasLOS;
-}
 // 
 // FString UBTDecorator_HasLoSTo::GetStaticDescription() const
 // {
@@ -8,6 +8,7 @@
 #include "Bots/ShooterAIController.h"
 #include "Bots/ShooterBot.h"
 #include "Pickups/ShooterPickup_Ammo.h"
+#include "Pickups/ShooterPickupIndex.h"
 #include "Weapons/ShooterWeapon_Instant.h"
 
 UBTTask_FindPickup::UBTTask_FindPickup(const FObjectInitializer& ObjectInitializer) 
@@ -24,29 +25,20 @@ EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent& Owne
 		return EBTNodeResult::Failed;
 	}
 
-	AShooterGameMode* GameMode = MyBot->GetWorld()->GetAuthGameMode<AShooterGameMode>();
-	if (GameMode == NULL)
+	UShooterPickupIndex* PickupIndex = UShooterPickupIndex::Get(MyBot);
+	if (PickupIndex == NULL)
 	{
 		return EBTNodeResult::Failed;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	AShooterPickup_Ammo* BestPickup = NULL;
-	float BestDistSq = MAX_FLT;
-
-	for (int32 i = 0; i < GameMode->LevelPickups.Num(); ++i)
+	// index holds only active pickups, remaining checks depend on bot's weapon and are done during search
+	TArray<AShooterPickup*> NearestPickups;
+	PickupIndex->FindNearest(AShooterWeapon_Instant::StaticClass(), MyBot->GetActorLocation(), 1, MAX_FLT, [MyBot](AShooterPickup* Pickup)
 	{
-		AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(GameMode->LevelPickups[i]);
-		if (AmmoPickup && AmmoPickup->IsForWeapon(AShooterWeapon_Instant::StaticClass()) && AmmoPickup->CanBePickedUp(MyBot))
-		{
-			const float DistSq = (AmmoPickup->GetActorLocation() - MyLoc).SizeSquared();
-			if (BestDistSq == -1 || DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPickup = AmmoPickup;
-			}
-		}
-	}
+		return Pickup->IsActive() && Pickup->IsA<AShooterPickup_Ammo>() && Pickup->CanBePickedUp(MyBot);
+	}, NearestPickups);
+
+	AShooterPickup_Ammo* BestPickup = (NearestPickups.Num() > 0) ? Cast<AShooterPickup_Ammo>(NearestPickups[0]) : NULL;
 
 	if (BestPickup)
 	{
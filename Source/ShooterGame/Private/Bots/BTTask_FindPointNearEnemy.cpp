@@ -3,6 +3,7 @@
 #include "ShooterGame.h"
 #include "Bots/BTTask_FindPointNearEnemy.h"
 #include "Bots/ShooterAIController.h"
+#include "Bots/ShooterTacticalPoints.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyAllTypes.h"
@@ -26,6 +27,15 @@ EBTNodeResult::Type UBTTask_FindPointNearEnemy::ExecuteTask(UBehaviorTreeCompone
 	AShooterCharacter* Enemy = MyController->GetEnemy();
 	if (Enemy && MyBot)
 	{
+		// cached points shared with other bots attacking same enemy
+		UShooterTacticalPoints* TacticalPoints = UShooterTacticalPoints::Get(MyBot);
+		FVector TacticalLoc;
+		if (TacticalPoints && TacticalPoints->FindPointNearEnemy(Enemy, MyBot, TacticalLoc))
+		{
+			OwnerComp.GetBlackboardComponent()->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), TacticalLoc);
+			return EBTNodeResult::Succeeded;
+		}
+
 		const float SearchRadius = 200.0f;
 		const FVector SearchOrigin = Enemy->GetActorLocation() + 600.0f * (MyBot->GetActorLocation() - Enemy->GetActorLocation()).GetSafeNormal();
 		FVector Loc(0);
@@ -10,14 +10,31 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "Weapons/ShooterWeapon.h"
+#include "Player/ShooterCharacterGrid.h"
+#include "Bots/ShooterBotScheduler.h"
+#include "Bots/ShooterPathFollowingComponent.h"
+#include "Bots/ShooterTacticalPoints.h"
 
-AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+DECLARE_CYCLE_STAT(TEXT("Bot Find Enemy"), STAT_ShooterBotFindEnemy, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS Traces"), STAT_ShooterBotLOSTraces, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS Cache Hits"), STAT_ShooterBotLOSCacheHits, STATGROUP_ShooterGame);
+
+float CVar_ShooterBot_LOSCacheTime = 0.2f;
+static FAutoConsoleVariableRef CVarShooterBotLOSCacheTime(TEXT("ShooterBot.LOSCacheTime"), CVar_ShooterBot_LOSCacheTime, TEXT("How long line of sight result is used before it's traced again"), ECVF_Default );
+
+float CVar_ShooterBot_LOSCacheTolerance = 50.f;
+static FAutoConsoleVariableRef CVarShooterBotLOSCacheTolerance(TEXT("ShooterBot.LOSCacheTolerance"), CVar_ShooterBot_LOSCacheTolerance, TEXT("Distance target location can move before its cached line of sight result is traced again"), ECVF_Default );
+
+AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterPathFollowingComponent>(TEXT("PathFollowingComponent")))
 {
  	BlackboardComp = ObjectInitializer.CreateDefaultSubobject<UBlackboardComponent>(this, TEXT("BlackBoardComp"));
  	
 	BrainComponent = BehaviorComp = ObjectInitializer.CreateDefaultSubobject<UBehaviorTreeComponent>(this, TEXT("BehaviorComp"));	
 
 	bWantsPlayerState = true;
+
+	LOSTraceDelegate.BindUObject(this, &AShooterAIController::OnLOSTraceDone);
 }
 
 void AShooterAIController::OnPossess(APawn* InPawn)
@@ -38,6 +55,12 @@ void AShooterAIController::OnPossess(APawn* InPawn)
 		NeedAmmoKeyID = BlackboardComp->GetKeyID("NeedAmmo");
 
 		BehaviorComp->StartTree(*(Bot->BotBehavior));
+
+		UShooterBotScheduler* Scheduler = UShooterBotScheduler::Get(this);
+		if (Scheduler)
+		{
+			Scheduler->RegisterBot(this);
+		}
 	}
 }
 
@@ -46,6 +69,13 @@ void AShooterAIController::OnUnPossess()
 	Super::OnUnPossess();
 
 	BehaviorComp->StopTree();
+	LOSCache.Reset();
+
+	UShooterBotScheduler* Scheduler = UShooterBotScheduler::Get(this);
+	if (Scheduler)
+	{
+		Scheduler->UnregisterBot(this);
+	}
 }
 
 void AShooterAIController::BeginInactiveState()
@@ -66,28 +96,19 @@ void AShooterAIController::Respawn()
 
 void AShooterAIController::FindClosestEnemy()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterBotFindEnemy);
+
 	APawn* MyBot = GetPawn();
-	if (MyBot == NULL)
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (MyBot == NULL || CharacterGrid == NULL)
 	{
 		return;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	float BestDistSq = MAX_FLT;
-	AShooterCharacter* BestPawn = NULL;
-
-	for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
+	AShooterCharacter* BestPawn = CharacterGrid->FindNearest(MyBot->GetActorLocation(), [this](AShooterCharacter* TestPawn)
 	{
-		if (TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-		{
-			const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-			if (DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPawn = TestPawn;
-			}
-		}
-	}
+		return TestPawn->IsAlive() && TestPawn->IsEnemyFor(this);
+	});
 
 	if (BestPawn)
 	{
@@ -97,29 +118,19 @@ void AShooterAIController::FindClosestEnemy()
 
 bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEnemy)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterBotFindEnemy);
+
 	bool bGotEnemy = false;
 	APawn* MyBot = GetPawn();
-	if (MyBot != NULL)
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (MyBot != NULL && CharacterGrid != NULL)
 	{
-		const FVector MyLoc = MyBot->GetActorLocation();
-		float BestDistSq = MAX_FLT;
-		AShooterCharacter* BestPawn = NULL;
-
-		for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
+		// candidates come closest first, so tracing stops at first visible enemy
+		AShooterCharacter* BestPawn = CharacterGrid->FindNearest(MyBot->GetActorLocation(), [this, ExcludeEnemy](AShooterCharacter* TestPawn)
 		{
-			if (TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-			{
-				if (HasWeaponLOSToEnemy(TestPawn, true) == true)
-				{
-					const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-					if (DistSq < BestDistSq)
-					{
-						BestDistSq = DistSq;
-						BestPawn = TestPawn;
-					}
-				}
-			}
-		}
+			return TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this) && HasWeaponLOSToEnemy(TestPawn, true);
+		});
+
 		if (BestPawn)
 		{
 			SetEnemy(BestPawn);
@@ -129,55 +140,115 @@ bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEne
 	return bGotEnemy;
 }
 
-bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const
+bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy)
 {
-	
-	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
+	return InEnemyActor ? GetCachedLOS(InEnemyActor, InEnemyActor->GetActorLocation(), bAnyEnemy) : false;
+}
 
-	bool bHasLOS = false;
-	// Perform trace to retrieve hit info
-	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AIWeaponLosTrace), true, GetPawn());
-
-	TraceParams.bReturnPhysicalMaterial = true;	
-	FVector StartLocation = MyBot->GetActorLocation();	
-	StartLocation.Z += GetPawn()->BaseEyeHeight; //look from eyes
-	
-	FHitResult Hit(ForceInit);
-	const FVector EndLocation = InEnemyActor->GetActorLocation();
-	GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-	if (Hit.bBlockingHit == true)
+bool AShooterAIController::GetCachedLOS(AActor* InEnemyActor, const FVector& TargetLocation, const bool bAnyEnemy)
+{
+	APawn* MyBot = GetPawn();
+	if (MyBot == NULL)
 	{
-		// Theres a blocking hit - check if its our enemy actor
-		AActor* HitActor = Hit.GetActor();
-		if (Hit.GetActor() != NULL)
+		return false;
+	}
+
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	FLOSCacheEntry* Entry = LOSCache.Find(InEnemyActor);
+	if (Entry == NULL)
+	{
+		PruneLOSCache();
+		Entry = &LOSCache.Add(InEnemyActor);
+	}
+
+	const bool bStale = (Entry->ResultTime < 0.0f)
+		|| (GameTime - Entry->ResultTime > CVar_ShooterBot_LOSCacheTime)
+		|| (InEnemyActor == NULL && FVector::DistSquared(Entry->TargetLocation, TargetLocation) > FMath::Square(CVar_ShooterBot_LOSCacheTolerance));
+
+	if (!bStale)
+	{
+		INC_DWORD_STAT(STAT_ShooterBotLOSCacheHits);
+	}
+	else if (!Entry->PendingTrace.IsValid())
+	{
+		// result arrives next frame, together with traces of all other bots
+		FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AIWeaponLosTrace), true, MyBot);
+
+		FVector StartLocation = MyBot->GetActorLocation();
+		StartLocation.Z += MyBot->BaseEyeHeight; //look from eyes
+
+		INC_DWORD_STAT(STAT_ShooterBotLOSTraces);
+		Entry->TargetLocation = TargetLocation;
+		Entry->PendingTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartLocation, TargetLocation, COLLISION_WEAPON, TraceParams, FCollisionResponseParams::DefaultResponseParam, &LOSTraceDelegate);
+	}
+
+	// last known result, until pending trace completes
+	return bAnyEnemy ? Entry->bHasLOSToAnyEnemy : Entry->bHasLOS;
+}
+
+void AShooterAIController::OnLOSTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	for (TPair<TWeakObjectPtr<AActor>, FLOSCacheEntry>& CachePair : LOSCache)
+	{
+		FLOSCacheEntry& Entry = CachePair.Value;
+		if (Entry.PendingTrace != TraceHandle)
 		{
-			if (HitActor == InEnemyActor)
-			{
-				bHasLOS = true;
-			}
-			else if (bAnyEnemy == true)
+			continue;
+		}
+
+		Entry.PendingTrace = FTraceHandle();
+		Entry.ResultTime = GetWorld()->GetTimeSeconds();
+		Entry.bHasLOS = false;
+		Entry.bHasLOSToAnyEnemy = false;
+
+		const FHitResult* Hit = (TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit) ? &TraceData.OutHits[0] : NULL;
+		if (Hit == NULL)
+		{
+			return;
+		}
+
+		AActor* EnemyActor = CachePair.Key.Get();
+		AActor* HitActor = Hit->GetActor();
+		if (HitActor != NULL)
+		{
+			Entry.bHasLOS = (EnemyActor != NULL && HitActor == EnemyActor);
+			Entry.bHasLOSToAnyEnemy = Entry.bHasLOS;
+
+			// Its not our actor, maybe its still an enemy ?
+			ACharacter* HitChar = Cast<ACharacter>(HitActor);
+			if (!Entry.bHasLOSToAnyEnemy && HitChar != NULL)
 			{
-				// Its not our actor, maybe its still an enemy ?
-				ACharacter* HitChar = Cast<ACharacter>(HitActor);
-				if (HitChar != NULL)
+				AShooterPlayerState* HitPlayerState = Cast<AShooterPlayerState>(HitChar->GetPlayerState());
+				AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(PlayerState);
+				if ((HitPlayerState != NULL) && (MyPlayerState != NULL))
 				{
-					AShooterPlayerState* HitPlayerState = Cast<AShooterPlayerState>(HitChar->GetPlayerState());
-					AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(PlayerState);
-					if ((HitPlayerState != NULL) && (MyPlayerState != NULL))
-					{
-						if (HitPlayerState->GetTeamNum() != MyPlayerState->GetTeamNum())
-						{
-							bHasLOS = true;
-						}
-					}
+					Entry.bHasLOSToAnyEnemy = (HitPlayerState->GetTeamNum() != MyPlayerState->GetTeamNum());
 				}
 			}
 		}
+		else if (!CachePair.Key.IsValid() && !CachePair.Key.IsStale())
+		{
+			// testing location - what we hit is further away than the target, so we should be able to hit our target
+			const FVector HitDelta = Hit->ImpactPoint - TraceData.Start;
+			const FVector TargetDelta = TraceData.End - TraceData.Start;
+			Entry.bHasLOS = (TargetDelta.SizeSquared() < HitDelta.SizeSquared());
+			Entry.bHasLOSToAnyEnemy = Entry.bHasLOS;
+		}
+		return;
 	}
+}
 
-	
-
-	return bHasLOS;
+void AShooterAIController::PruneLOSCache()
+{
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	for (auto It = LOSCache.CreateIterator(); It; ++It)
+	{
+		const FLOSCacheEntry& Entry = It.Value();
+		if (It.Key().IsStale() || (!Entry.PendingTrace.IsValid() && GameTime - Entry.ResultTime > CVar_ShooterBot_LOSCacheTime * 10.0f))
+		{
+			It.RemoveCurrent();
+		}
+	}
 }
 
 void AShooterAIController::ShootEnemy()
@@ -193,7 +264,7 @@ void AShooterAIController::ShootEnemy()
 	AShooterCharacter* Enemy = GetEnemy();
 	if ( Enemy && ( Enemy->IsAlive() )&& (MyWeapon->GetCurrentAmmo() > 0) && ( MyWeapon->CanFire() == true ) )
 	{
-		if (LineOfSightTo(Enemy, MyBot->GetActorLocation()))
+		if (HasWeaponLOSToEnemy(Enemy, false))
 		{
 			bCanShoot = true;
 		}
@@ -225,6 +296,13 @@ void AShooterAIController::SetEnemy(class APawn* InPawn)
 {
 	if (BlackboardComp)
 	{
+		// point claimed against old enemy is free for other bots
+		UShooterTacticalPoints* TacticalPoints = UShooterTacticalPoints::Get(this);
+		if (TacticalPoints && GetPawn() && GetEnemy() != InPawn)
+		{
+			TacticalPoints->ReleaseClaims(GetPawn());
+		}
+
 		BlackboardComp->SetValue<UBlackboardKeyType_Object>(EnemyKeyID, InPawn);
 		SetFocus(InPawn);
 	}
@@ -0,0 +1,192 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBotScheduler.h"
+#include "Bots/ShooterAIController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Bot Scheduler"), STAT_ShooterBotScheduler, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scheduled Bots"), STAT_ShooterScheduledBots, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot Decisions"), STAT_ShooterBotDecisions, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot Decisions Overdue"), STAT_ShooterBotDecisionsOverdue, STATGROUP_ShooterGame);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Bot Scheduling Latency Max (ms)"), STAT_ShooterBotSchedulingLatency, STATGROUP_ShooterGame);
+
+float CVar_ShooterBotScheduler_Budget = 2.0f;
+static FAutoConsoleVariableRef CVarShooterBotSchedulerBudget(TEXT("ShooterBotScheduler.Budget"), CVar_ShooterBotScheduler_Budget, TEXT("Time in ms spent on bot decisions per frame, at least one bot is always updated"), ECVF_Default );
+
+float CVar_ShooterBotScheduler_NearDistance = 3000.f;
+static FAutoConsoleVariableRef CVarShooterBotSchedulerNearDistance(TEXT("ShooterBotScheduler.NearDistance"), CVar_ShooterBotScheduler_NearDistance, TEXT("Bots closer to human player use NearInterval"), ECVF_Default );
+
+float CVar_ShooterBotScheduler_FarDistance = 10000.f;
+static FAutoConsoleVariableRef CVarShooterBotSchedulerFarDistance(TEXT("ShooterBotScheduler.FarDistance"), CVar_ShooterBotScheduler_FarDistance, TEXT("Bots further from all human players use FarInterval"), ECVF_Default );
+
+float CVar_ShooterBotScheduler_NearInterval = 0.05f;
+static FAutoConsoleVariableRef CVarShooterBotSchedulerNearInterval(TEXT("ShooterBotScheduler.NearInterval"), CVar_ShooterBotScheduler_NearInterval, TEXT("Time between decisions of bots near human players, also used when there are no humans"), ECVF_Default );
+
+float CVar_ShooterBotScheduler_FarInterval = 0.5f;
+static FAutoConsoleVariableRef CVarShooterBotSchedulerFarInterval(TEXT("ShooterBotScheduler.FarInterval"), CVar_ShooterBotScheduler_FarInterval, TEXT("Time between decisions of bots far from human players"), ECVF_Default );
+
+UShooterBotScheduler* UShooterBotScheduler::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterBotScheduler>() : NULL;
+}
+
+void UShooterBotScheduler::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterScheduledBots, Bots.Num());
+	Bots.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UShooterBotScheduler::IsTickable() const
+{
+	return Bots.Num() > 0 && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UShooterBotScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterBotScheduler, STATGROUP_Tickables);
+}
+
+UWorld* UShooterBotScheduler::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterBotScheduler::RegisterBot(AShooterAIController* Bot)
+{
+	if (Bot == NULL || Bot->GetBehaviorComp() == NULL)
+	{
+		return;
+	}
+
+	// scheduler ticks it from now on
+	Bot->GetBehaviorComp()->SetComponentTickEnabled(false);
+
+	for (const FScheduledBot& ScheduledBot : Bots)
+	{
+		if (ScheduledBot.Controller == Bot)
+		{
+			return;
+		}
+	}
+
+	FScheduledBot NewBot;
+	NewBot.Controller = Bot;
+	NewBot.LastUpdateTime = GetWorld()->GetTimeSeconds();
+	NewBot.UpdateInterval = CVar_ShooterBotScheduler_NearInterval;
+	NewBot.Priority = 0.0f;
+	Bots.Add(NewBot);
+	INC_DWORD_STAT(STAT_ShooterScheduledBots);
+}
+
+void UShooterBotScheduler::UnregisterBot(AShooterAIController* Bot)
+{
+	for (int32 BotIdx = 0; BotIdx < Bots.Num(); BotIdx++)
+	{
+		if (Bots[BotIdx].Controller == Bot)
+		{
+			Bots.RemoveAtSwap(BotIdx);
+			DEC_DWORD_STAT(STAT_ShooterScheduledBots);
+			break;
+		}
+	}
+
+	if (Bot && Bot->GetBehaviorComp())
+	{
+		Bot->GetBehaviorComp()->SetComponentTickEnabled(true);
+	}
+}
+
+void UShooterBotScheduler::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterBotScheduler);
+
+	UWorld* World = GetWorld();
+	const float GameTime = World->GetTimeSeconds();
+
+	TArray<FVector> HumanLocations;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->GetPawn())
+		{
+			HumanLocations.Add(PC->GetPawn()->GetActorLocation());
+		}
+	}
+
+	for (int32 BotIdx = Bots.Num() - 1; BotIdx >= 0; BotIdx--)
+	{
+		FScheduledBot& ScheduledBot = Bots[BotIdx];
+		const AShooterAIController* Bot = ScheduledBot.Controller.Get();
+		if (Bot == NULL || Bot->IsPendingKill())
+		{
+			Bots.RemoveAtSwap(BotIdx);
+			DEC_DWORD_STAT(STAT_ShooterScheduledBots);
+			continue;
+		}
+
+		ScheduledBot.UpdateInterval = GetUpdateInterval(Bot, HumanLocations);
+		ScheduledBot.Priority = (GameTime - ScheduledBot.LastUpdateTime) / ScheduledBot.UpdateInterval;
+	}
+
+	// most overdue first
+	Bots.Sort([](const FScheduledBot& A, const FScheduledBot& B) { return A.Priority > B.Priority; });
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = CVar_ShooterBotScheduler_Budget / 1000.0;
+	float MaxLatency = 0.0f;
+	int32 NumUpdated = 0;
+
+	for (FScheduledBot& ScheduledBot : Bots)
+	{
+		if (ScheduledBot.Priority < 1.0f)
+		{
+			break;
+		}
+
+		if (NumUpdated > 0 && FPlatformTime::Seconds() - StartTime >= Budget)
+		{
+			INC_DWORD_STAT(STAT_ShooterBotDecisionsOverdue);
+			continue;
+		}
+
+		// behavior tree drives enemy search, shooting and line of sight requests
+		UBehaviorTreeComponent* BehaviorComp = ScheduledBot.Controller->GetBehaviorComp();
+		if (BehaviorComp && BehaviorComp->IsRegistered())
+		{
+			BehaviorComp->TickComponent(GameTime - ScheduledBot.LastUpdateTime, LEVELTICK_All, NULL);
+		}
+
+		MaxLatency = FMath::Max(MaxLatency, GameTime - ScheduledBot.LastUpdateTime - ScheduledBot.UpdateInterval);
+		ScheduledBot.LastUpdateTime = GameTime;
+		NumUpdated++;
+	}
+
+	INC_DWORD_STAT_BY(STAT_ShooterBotDecisions, NumUpdated);
+	SET_FLOAT_STAT(STAT_ShooterBotSchedulingLatency, MaxLatency * 1000.0f);
+}
+
+float UShooterBotScheduler::GetUpdateInterval(const AShooterAIController* Bot, const TArray<FVector>& HumanLocations) const
+{
+	const float NearInterval = FMath::Max(CVar_ShooterBotScheduler_NearInterval, KINDA_SMALL_NUMBER);
+	const float FarInterval = FMath::Max(CVar_ShooterBotScheduler_FarInterval, NearInterval);
+
+	const APawn* BotPawn = Bot->GetPawn();
+	if (BotPawn == NULL || HumanLocations.Num() == 0)
+	{
+		return NearInterval;
+	}
+
+	float ClosestDistSq = MAX_FLT;
+	for (const FVector& HumanLocation : HumanLocations)
+	{
+		ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(HumanLocation, BotPawn->GetActorLocation()));
+	}
+
+	const float FarDistance = FMath::Max(CVar_ShooterBotScheduler_FarDistance, CVar_ShooterBotScheduler_NearDistance + 1.0f);
+	const float Alpha = FMath::GetRangePct(CVar_ShooterBotScheduler_NearDistance, FarDistance, FMath::Sqrt(ClosestDistSq));
+	return FMath::Lerp(NearInterval, FarInterval, FMath::Clamp(Alpha, 0.0f, 1.0f));
+}
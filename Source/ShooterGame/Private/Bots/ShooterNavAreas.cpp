@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterNavAreas.h"
+
+UShooterNavArea_Traversal::UShooterNavArea_Traversal(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	// abilities are slower than walking, prefer them only when they save a long detour
+	DefaultCost = 2.0f;
+}
+
+UShooterNavArea_Jetpack::UShooterNavArea_Jetpack(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	DrawColor = FColor::Orange;
+}
+
+UShooterNavArea_WallRun::UShooterNavArea_WallRun(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	DrawColor = FColor::Cyan;
+}
+
+UShooterNavArea_Teleport::UShooterNavArea_Teleport(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	DefaultCost = 1.5f;
+	DrawColor = FColor::Magenta;
+}
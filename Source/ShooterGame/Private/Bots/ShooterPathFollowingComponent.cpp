@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterPathFollowingComponent.h"
+#include "NavMesh/RecastNavMesh.h"
+
+UShooterPathFollowingComponent::UShooterPathFollowingComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	bIsTraversing = false;
+	TraversalType = EShooterTraversalType::Jetpack;
+	TraversalEnd = FVector::ZeroVector;
+}
+
+void UShooterPathFollowingComponent::SetMoveSegment(int32 SegmentStartIndex)
+{
+	Super::SetMoveSegment(SegmentStartIndex);
+
+	StopTraversal();
+
+	const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(MyNavData);
+	if (NavMesh == NULL || !Path.IsValid() || !Path->GetPathPoints().IsValidIndex(MoveSegmentEndIndex))
+	{
+		return;
+	}
+
+	// segment starting in traversal area is baked link
+	const FNavPathPoint& SegmentStart = Path->GetPathPoints()[MoveSegmentStartIndex];
+	const FNavPathPoint& SegmentEnd = Path->GetPathPoints()[MoveSegmentEndIndex];
+	const uint8 AreaID = FNavMeshNodeFlags(SegmentStart.Flags).Area;
+
+	EShooterTraversalType Type;
+	if (AShooterTraversalLinks::GetTraversalType(NavMesh->GetAreaClass(AreaID), Type))
+	{
+		StartTraversal(Type, SegmentStart.Location, SegmentEnd.Location);
+	}
+}
+
+void UShooterPathFollowingComponent::FollowPathSegment(float DeltaTime)
+{
+	Super::FollowPathSegment(DeltaTime);
+
+	UShooterCharacterMovement* MoveComp = bIsTraversing ? GetShooterMovement() : NULL;
+	if (MoveComp && TraversalType == EShooterTraversalType::Jetpack)
+	{
+		// keep thrust until feet are above ledge, path following steers over it
+		const float FeetZ = MoveComp->GetActorFeetLocation().Z;
+		MoveComp->DoActivateJetpack(FeetZ < TraversalEnd.Z + 50.0f);
+	}
+}
+
+void UShooterPathFollowingComponent::OnPathFinished(const FPathFollowingResult& Result)
+{
+	StopTraversal();
+
+	Super::OnPathFinished(Result);
+}
+
+UShooterCharacterMovement* UShooterPathFollowingComponent::GetShooterMovement() const
+{
+	const AController* Controller = Cast<AController>(GetOwner());
+	const APawn* Pawn = Controller ? Controller->GetPawn() : NULL;
+	return Pawn ? Cast<UShooterCharacterMovement>(Pawn->GetMovementComponent()) : NULL;
+}
+
+void UShooterPathFollowingComponent::StartTraversal(EShooterTraversalType Type, const FVector& Start, const FVector& End)
+{
+	UShooterCharacterMovement* MoveComp = GetShooterMovement();
+	if (MoveComp == NULL)
+	{
+		return;
+	}
+
+	bIsTraversing = true;
+	TraversalType = Type;
+	TraversalEnd = End;
+
+	switch (Type)
+	{
+		case EShooterTraversalType::Jetpack:
+			MoveComp->DoActivateJetpack(true);
+			break;
+
+		case EShooterTraversalType::WallRun:
+			// wall run starts in air, path following moves along wall
+			if (MoveComp->GetCharacterOwner())
+			{
+				MoveComp->GetCharacterOwner()->Jump();
+			}
+			MoveComp->DoWallRun(true);
+			break;
+
+		case EShooterTraversalType::Teleport:
+			MoveComp->DoTeleportInDirection((End - Start).GetSafeNormal2D());
+			break;
+	}
+}
+
+void UShooterPathFollowingComponent::StopTraversal()
+{
+	if (!bIsTraversing)
+	{
+		return;
+	}
+
+	bIsTraversing = false;
+
+	UShooterCharacterMovement* MoveComp = GetShooterMovement();
+	if (MoveComp)
+	{
+		MoveComp->DoActivateJetpack(false);
+		MoveComp->DoWallRun(false);
+		if (MoveComp->GetCharacterOwner())
+		{
+			MoveComp->GetCharacterOwner()->StopJumping();
+		}
+	}
+}
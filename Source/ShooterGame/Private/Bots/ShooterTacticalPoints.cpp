@@ -0,0 +1,375 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterTacticalPoints.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "GameFramework/PlayerStart.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tactical Point Query"), STAT_ShooterTacticalQuery, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Tactical Point Build"), STAT_ShooterTacticalBuild, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tactical Point Queries"), STAT_ShooterTacticalQueries, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tactical Point Shared Scores"), STAT_ShooterTacticalSharedScores, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tactical Point Nav Queries"), STAT_ShooterTacticalNavQueries, STATGROUP_ShooterGame);
+
+float CVar_ShooterTactical_PointSpacing = 300.f;
+static FAutoConsoleVariableRef CVarShooterTacticalPointSpacing(TEXT("ShooterTactical.PointSpacing"), CVar_ShooterTactical_PointSpacing, TEXT("Distance between tactical points sampled from navmesh, applied on map load"), ECVF_Default );
+
+float CVar_ShooterTactical_PreferredDistance = 600.f;
+static FAutoConsoleVariableRef CVarShooterTacticalPreferredDistance(TEXT("ShooterTactical.PreferredDistance"), CVar_ShooterTactical_PreferredDistance, TEXT("Best distance of tactical point from enemy"), ECVF_Default );
+
+float CVar_ShooterTactical_DistanceRange = 300.f;
+static FAutoConsoleVariableRef CVarShooterTacticalDistanceRange(TEXT("ShooterTactical.DistanceRange"), CVar_ShooterTactical_DistanceRange, TEXT("How much tactical point distance from enemy can differ from preferred one"), ECVF_Default );
+
+float CVar_ShooterTactical_CacheTime = 1.0f;
+static FAutoConsoleVariableRef CVarShooterTacticalCacheTime(TEXT("ShooterTactical.CacheTime"), CVar_ShooterTactical_CacheTime, TEXT("How long scored points around enemy are reused"), ECVF_Default );
+
+float CVar_ShooterTactical_EnemyMoveTolerance = 200.f;
+static FAutoConsoleVariableRef CVarShooterTacticalEnemyMoveTolerance(TEXT("ShooterTactical.EnemyMoveTolerance"), CVar_ShooterTactical_EnemyMoveTolerance, TEXT("Distance enemy can move before points around it are scored again"), ECVF_Default );
+
+/** weights of point score terms */
+static const float CoverWeight = 0.5f;
+static const float FlankWeight = 0.5f;
+static const float ApproachWeight = 0.5f;
+static const float TravelWeight = 0.5f;
+static const float ClaimedPenalty = 1.0f;
+
+/** max path tests per query */
+static const int32 MaxReachabilityTests = 4;
+
+UShooterTacticalPoints::UShooterTacticalPoints()
+{
+	CellSize = 1000.0f;
+	bBuilt = false;
+	ReachabilityOrigin = FVector::ZeroVector;
+	NumNavQueries = 0;
+}
+
+UShooterTacticalPoints* UShooterTacticalPoints::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterTacticalPoints>() : NULL;
+}
+
+void UShooterTacticalPoints::Deinitialize()
+{
+	Points.Empty();
+	Cells.Empty();
+	EnemyCandidates.Empty();
+	bBuilt = false;
+
+	Super::Deinitialize();
+}
+
+bool UShooterTacticalPoints::FindPointNearEnemy(const AActor* Enemy, const APawn* Bot, FVector& OutLocation)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterTacticalQuery);
+	INC_DWORD_STAT(STAT_ShooterTacticalQueries);
+
+	if (Enemy == NULL || Bot == NULL)
+	{
+		return false;
+	}
+
+	// built by game mode at match start, in case bots asked earlier
+	if (!bBuilt)
+	{
+		BuildPoints();
+	}
+
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	FEnemyCandidates* Candidates = EnemyCandidates.Find(Enemy);
+	if (Candidates == NULL)
+	{
+		// forget enemies nobody attacked for a while
+		for (auto It = EnemyCandidates.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid() || GameTime - It.Value().ScoreTime > CVar_ShooterTactical_CacheTime * 10.0f)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		Candidates = &EnemyCandidates.Add(Enemy);
+		ScoreCandidates(Enemy, *Candidates);
+	}
+	else if (GameTime - Candidates->ScoreTime > CVar_ShooterTactical_CacheTime
+		|| FVector::DistSquared(Candidates->EnemyLocation, Enemy->GetActorLocation()) > FMath::Square(CVar_ShooterTactical_EnemyMoveTolerance))
+	{
+		ScoreCandidates(Enemy, *Candidates);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ShooterTacticalSharedScores);
+	}
+
+	// bot's previous point is free again, also when it was attacking other enemy
+	ReleaseClaims(Bot);
+
+	const FVector EnemyLoc = Candidates->EnemyLocation;
+	const FVector BotLoc = Bot->GetActorLocation();
+	const FVector ToBotDir = (BotLoc - EnemyLoc).GetSafeNormal2D();
+	const float PreferredDistance = FMath::Max(CVar_ShooterTactical_PreferredDistance, 1.0f);
+
+	TArray<TPair<float, int32>, TInlineAllocator<64>> BotScored;
+	for (const TPair<float, int32>& Scored : Candidates->Scored)
+	{
+		const FTacticalPoint& Point = Points[Scored.Value];
+		if (Point.Reachable == 0)
+		{
+			continue;
+		}
+
+		// approach from bot's side, don't cross whole map
+		float Score = Scored.Key;
+		Score += ApproachWeight * FVector::DotProduct((Point.Location - EnemyLoc).GetSafeNormal2D(), ToBotDir);
+		Score -= TravelWeight * FVector::Dist(Point.Location, BotLoc) / PreferredDistance;
+
+		for (const TPair<TWeakObjectPtr<const APawn>, int32>& Claim : Candidates->Claims)
+		{
+			if (Claim.Value == Scored.Value)
+			{
+				Score -= ClaimedPenalty;
+			}
+		}
+
+		BotScored.Add(TPair<float, int32>(Score, Scored.Value));
+	}
+
+	BotScored.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; });
+
+	int32 NumTests = 0;
+	for (const TPair<float, int32>& Scored : BotScored)
+	{
+		const bool bKnown = Points[Scored.Value].Reachable >= 0;
+		if (!bKnown && NumTests >= MaxReachabilityTests)
+		{
+			continue;
+		}
+
+		NumTests += bKnown ? 0 : 1;
+		if (IsReachable(Scored.Value))
+		{
+			Candidates->Claims.Add(Bot, Scored.Value);
+			OutLocation = Points[Scored.Value].Location;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UShooterTacticalPoints::ReleaseClaims(const APawn* Bot)
+{
+	for (TPair<TWeakObjectPtr<const AActor>, FEnemyCandidates>& Candidates : EnemyCandidates)
+	{
+		Candidates.Value.Claims.Remove(Bot);
+	}
+}
+
+void UShooterTacticalPoints::ScoreCandidates(const AActor* Enemy, FEnemyCandidates& Candidates)
+{
+	Candidates.EnemyLocation = Enemy->GetActorLocation();
+	Candidates.ScoreTime = GetWorld()->GetTimeSeconds();
+	Candidates.Scored.Reset();
+
+	for (auto It = Candidates.Claims.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const float PreferredDistance = FMath::Max(CVar_ShooterTactical_PreferredDistance, 1.0f);
+	const float MinDistance = FMath::Max(PreferredDistance - CVar_ShooterTactical_DistanceRange, 0.0f);
+	const float MaxDistance = PreferredDistance + CVar_ShooterTactical_DistanceRange;
+	const FVector EnemyLoc = Candidates.EnemyLocation;
+	const FVector EnemyForward = Enemy->GetActorForwardVector().GetSafeNormal2D();
+
+	const FIntPoint MinCell = GetCell(EnemyLoc - FVector(MaxDistance));
+	const FIntPoint MaxCell = GetCell(EnemyLoc + FVector(MaxDistance));
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(CellX, CellY));
+			if (Cell == NULL)
+			{
+				continue;
+			}
+
+			for (int32 PointIdx : *Cell)
+			{
+				const FTacticalPoint& Point = Points[PointIdx];
+				const float Dist = FVector::Dist(Point.Location, EnemyLoc);
+				if (Point.Reachable == 0 || Dist < MinDistance || Dist > MaxDistance)
+				{
+					continue;
+				}
+
+				// close to preferred distance, in cover, and away from where enemy looks
+				float Score = -FMath::Abs(Dist - PreferredDistance) / PreferredDistance;
+				Score += CoverWeight * Point.NumCover / 8.0f;
+				Score += FlankWeight * (1.0f - FVector::DotProduct(EnemyForward, (Point.Location - EnemyLoc).GetSafeNormal2D())) * 0.5f;
+
+				Candidates.Scored.Add(TPair<float, int32>(Score, PointIdx));
+			}
+		}
+	}
+}
+
+void UShooterTacticalPoints::BuildPoints()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterTacticalBuild);
+
+	bBuilt = true;
+	Points.Reset();
+	Cells.Reset();
+
+	UWorld* World = GetWorld();
+
+#if WITH_RECAST
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : NULL;
+	if (NavMesh == NULL)
+	{
+		return;
+	}
+
+	// without spawn on navmesh there is nothing to test reachability against
+	bool bHasReachabilityOrigin = false;
+	for (TActorIterator<APlayerStart> It(World); It && !bHasReachabilityOrigin; ++It)
+	{
+		FNavLocation SpawnNavLocation;
+		if (NavSys->ProjectPointToNavigation(It->GetActorLocation(), SpawnNavLocation, FVector(100.0f, 100.0f, 250.0f), NavMesh))
+		{
+			ReachabilityOrigin = SpawnNavLocation.Location;
+			bHasReachabilityOrigin = true;
+		}
+	}
+
+	const float PointSpacing = FMath::Max(CVar_ShooterTactical_PointSpacing, 50.0f);
+	const FVector CoverOffset(0.0f, 0.0f, 60.0f);
+	const float CoverDistance = 150.0f;
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(ShooterTacticalCover), false);
+
+	TSet<FIntVector> UsedCells;
+	for (int32 TileIdx = 0; TileIdx < NavMesh->GetNavMeshTilesCount(); TileIdx++)
+	{
+		TArray<FNavPoly> Polys;
+		NavMesh->GetPolysInTile(TileIdx, Polys);
+
+		for (const FNavPoly& Poly : Polys)
+		{
+			const FIntVector SampleCell(FMath::FloorToInt(Poly.Center.X / PointSpacing), FMath::FloorToInt(Poly.Center.Y / PointSpacing), FMath::FloorToInt(Poly.Center.Z / PointSpacing));
+			if (UsedCells.Contains(SampleCell))
+			{
+				continue;
+			}
+			UsedCells.Add(SampleCell);
+
+			FTacticalPoint Point;
+			Point.Location = Poly.Center;
+			Point.CoverMask = 0;
+			Point.NumCover = 0;
+			Point.Reachable = bHasReachabilityOrigin ? -1 : 1;
+
+			// cover is anything stopping bullets close to crouching character
+			for (int32 DirIdx = 0; DirIdx < 8; DirIdx++)
+			{
+				const FVector TraceStart = Poly.Center + CoverOffset;
+				const FVector TraceEnd = TraceStart + FRotator(0.0f, DirIdx * 45.0f, 0.0f).Vector() * CoverDistance;
+				if (World->LineTraceTestByChannel(TraceStart, TraceEnd, COLLISION_WEAPON, TraceParams))
+				{
+					Point.CoverMask |= (1 << DirIdx);
+					Point.NumCover++;
+				}
+			}
+
+			Cells.FindOrAdd(GetCell(Point.Location)).Add(Points.Add(Point));
+		}
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Built %d tactical points"), Points.Num());
+#endif // WITH_RECAST
+}
+
+bool UShooterTacticalPoints::IsReachable(int32 PointIdx)
+{
+	FTacticalPoint& Point = Points[PointIdx];
+	if (Point.Reachable < 0)
+	{
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+		const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : NULL;
+		if (NavData == NULL)
+		{
+			return false;
+		}
+
+		// everything reachable from spawns is reachable for bots, result doesn't depend on querier
+		NumNavQueries++;
+		INC_DWORD_STAT(STAT_ShooterTacticalNavQueries);
+		const FPathFindingQuery Query(this, *NavData, ReachabilityOrigin, Point.Location);
+		Point.Reachable = NavSys->TestPathSync(Query, EPathFindingMode::Hierarchical) ? 1 : 0;
+	}
+
+	return Point.Reachable > 0;
+}
+
+FIntPoint UShooterTacticalPoints::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterTacticalBenchmarkCmd(TEXT("ShooterTactical.Benchmark"), TEXT("Compares navmesh random point queries with tactical point queries, between all characters. Optional arg: number of queries."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		int32 NumQueries = 1000;
+		if (Args.Num() > 0)
+		{
+			LexTryParseString<int32>(NumQueries, *Args[0]);
+		}
+
+		TArray<AShooterCharacter*> Characters;
+		for (TActorIterator<AShooterCharacter> It(World); It; ++It)
+		{
+			Characters.Add(*It);
+		}
+
+		UShooterTacticalPoints* TacticalPoints = UShooterTacticalPoints::Get(World);
+		if (TacticalPoints == NULL || Characters.Num() < 2 || NumQueries <= 0)
+		{
+			UE_LOG(LogShooter, Warning, TEXT("Tactical benchmark needs game world with at least 2 characters"));
+			return;
+		}
+
+		// same query BTTask_FindPointNearEnemy did before
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; QueryIdx++)
+		{
+			const AShooterCharacter* Enemy = Characters[QueryIdx % Characters.Num()];
+			const AShooterCharacter* Bot = Characters[(QueryIdx + 1) % Characters.Num()];
+			const FVector SearchOrigin = Enemy->GetActorLocation() + 600.0f * (Bot->GetActorLocation() - Enemy->GetActorLocation()).GetSafeNormal();
+			FVector Loc(0);
+			UNavigationSystemV1::K2_GetRandomReachablePointInRadius(World, SearchOrigin, Loc, 200.0f);
+		}
+		const double NavMeshTime = FPlatformTime::Seconds() - StartTime;
+
+		// build points outside of measured time
+		FVector Loc;
+		TacticalPoints->FindPointNearEnemy(Characters[0], Characters[1], Loc);
+
+		const int32 StartNavQueries = TacticalPoints->GetNumNavQueries();
+		StartTime = FPlatformTime::Seconds();
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; QueryIdx++)
+		{
+			TacticalPoints->FindPointNearEnemy(Characters[QueryIdx % Characters.Num()], Characters[(QueryIdx + 1) % Characters.Num()], Loc);
+		}
+		const double TacticalTime = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogShooter, Display, TEXT("Tactical benchmark, %d queries between %d characters:"), NumQueries, Characters.Num());
+		UE_LOG(LogShooter, Display, TEXT("  navmesh random point: %.0f queries/s, %d navmesh queries"), NumQueries / FMath::Max(NavMeshTime, 1e-6), NumQueries);
+		UE_LOG(LogShooter, Display, TEXT("  tactical points: %.0f queries/s, %d navmesh queries"), NumQueries / FMath::Max(TacticalTime, 1e-6), TacticalPoints->GetNumNavQueries() - StartNavQueries);
+	})
+);
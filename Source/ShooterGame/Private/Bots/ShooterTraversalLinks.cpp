@@ -0,0 +1,310 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterTraversalLinks.h"
+#include "Bots/ShooterNavAreas.h"
+#include "AI/NavigationSystemHelpers.h"
+#include "AI/NavigationModifier.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+
+AShooterTraversalLinks::AShooterTraversalLinks(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	RootComponent = ObjectInitializer.CreateDefaultSubobject<USceneComponent>(this, TEXT("Root"));
+	RootComponent->SetMobility(EComponentMobility::Static);
+
+	SampleSpacing = 200.0f;
+	MinJetpackHeight = 250.0f;
+	MaxJetpackHeight = 1200.0f;
+	MaxJetpackDistance = 600.0f;
+	TeleportDistance = 1000.0f;
+	TeleportSpacing = 800.0f;
+	MaxLinksPerSample = 2;
+	MinDetourRatio = 2.5f;
+	AgentRadius = 42.0f;
+	AgentHalfHeight = 96.0f;
+
+	LinksBounds = FBox(ForceInit);
+}
+
+void AShooterTraversalLinks::PostRegisterAllComponents()
+{
+	// links have to be ready before navigation system gathers them
+	UpdateNavLinks();
+
+	Super::PostRegisterAllComponents();
+}
+
+bool AShooterTraversalLinks::GetNavigationLinksClasses(TArray<TSubclassOf<UNavLinkDefinition>>& OutClasses) const
+{
+	return false;
+}
+
+bool AShooterTraversalLinks::GetNavigationLinksArray(TArray<FNavigationLink>& OutLink, TArray<FNavigationSegmentLink>& OutSegments) const
+{
+	OutLink.Append(NavLinks);
+	return NavLinks.Num() > 0;
+}
+
+void AShooterTraversalLinks::GetNavigationData(FNavigationRelevantData& Data) const
+{
+	NavigationHelper::ProcessNavLinkAndAppend(&Data.Modifiers, this, NavLinks);
+}
+
+FBox AShooterTraversalLinks::GetNavigationBounds() const
+{
+	return LinksBounds;
+}
+
+bool AShooterTraversalLinks::IsNavigationRelevant() const
+{
+	return NavLinks.Num() > 0;
+}
+
+bool AShooterTraversalLinks::GetTraversalType(const UClass* AreaClass, EShooterTraversalType& OutType)
+{
+	if (AreaClass == NULL)
+	{
+		return false;
+	}
+
+	if (AreaClass->IsChildOf(UShooterNavArea_Jetpack::StaticClass()))
+	{
+		OutType = EShooterTraversalType::Jetpack;
+		return true;
+	}
+
+	if (AreaClass->IsChildOf(UShooterNavArea_WallRun::StaticClass()))
+	{
+		OutType = EShooterTraversalType::WallRun;
+		return true;
+	}
+
+	if (AreaClass->IsChildOf(UShooterNavArea_Teleport::StaticClass()))
+	{
+		OutType = EShooterTraversalType::Teleport;
+		return true;
+	}
+
+	return false;
+}
+
+void AShooterTraversalLinks::UpdateNavLinks()
+{
+	NavLinks.Reset(Links.Num());
+	LinksBounds = FBox(ForceInit);
+
+	const FTransform& ActorTransform = GetActorTransform();
+	for (const FShooterTraversalLink& Link : Links)
+	{
+		FNavigationLink NavLink(Link.Start, Link.End);
+		NavLink.Direction = ENavLinkDirection::LeftToRight;
+
+		switch (Link.Type)
+		{
+			case EShooterTraversalType::Jetpack:	NavLink.SetAreaClass(UShooterNavArea_Jetpack::StaticClass()); break;
+			case EShooterTraversalType::WallRun:	NavLink.SetAreaClass(UShooterNavArea_WallRun::StaticClass()); break;
+			case EShooterTraversalType::Teleport:	NavLink.SetAreaClass(UShooterNavArea_Teleport::StaticClass()); break;
+		}
+
+		NavLinks.Add(NavLink);
+		LinksBounds += ActorTransform.TransformPosition(Link.Start);
+		LinksBounds += ActorTransform.TransformPosition(Link.End);
+	}
+
+	if (LinksBounds.IsValid)
+	{
+		LinksBounds = LinksBounds.ExpandBy(FVector(AgentRadius, AgentRadius, AgentHalfHeight));
+	}
+}
+
+#if WITH_EDITOR
+
+void AShooterTraversalLinks::BakeLinks()
+{
+#if WITH_RECAST
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : NULL;
+	if (NavMesh == NULL)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Can't bake traversal links, map has no navmesh"));
+		return;
+	}
+
+	Modify();
+	Links.Reset();
+
+	// sample navmesh at poly centers, merged on grid
+	TArray<FVector> Samples;
+	TSet<FIntVector> UsedCells;
+	for (int32 TileIdx = 0; TileIdx < NavMesh->GetNavMeshTilesCount(); TileIdx++)
+	{
+		TArray<FNavPoly> Polys;
+		NavMesh->GetPolysInTile(TileIdx, Polys);
+
+		for (const FNavPoly& Poly : Polys)
+		{
+			const FIntVector Cell(FMath::FloorToInt(Poly.Center.X / SampleSpacing), FMath::FloorToInt(Poly.Center.Y / SampleSpacing), FMath::FloorToInt(Poly.Center.Z / SampleSpacing));
+			if (!UsedCells.Contains(Cell))
+			{
+				UsedCells.Add(Cell);
+				Samples.Add(Poly.Center);
+			}
+		}
+	}
+
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(AgentRadius, AgentHalfHeight);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterTraversalBake), false);
+	const FVector AgentOffset(0.0f, 0.0f, AgentHalfHeight);
+
+	// jetpack: straight up, then over the ledge
+	for (const FVector& Start : Samples)
+	{
+		TArray<TPair<float, FVector>> Candidates;
+		for (const FVector& End : Samples)
+		{
+			const float Height = End.Z - Start.Z;
+			const float DistSq2D = FVector::DistSquared2D(Start, End);
+			if (Height >= MinJetpackHeight && Height <= MaxJetpackHeight && DistSq2D <= FMath::Square(MaxJetpackDistance))
+			{
+				Candidates.Add(TPair<float, FVector>(DistSq2D, End));
+			}
+		}
+
+		Candidates.Sort([](const TPair<float, FVector>& A, const TPair<float, FVector>& B) { return A.Key < B.Key; });
+
+		int32 NumAdded = 0;
+		for (int32 CandidateIdx = 0; CandidateIdx < Candidates.Num() && NumAdded < MaxLinksPerSample; CandidateIdx++)
+		{
+			const FVector& End = Candidates[CandidateIdx].Value;
+			const FVector Apex(Start.X, Start.Y, End.Z + AgentHalfHeight * 2.0f);
+			if (!World->SweepTestByChannel(Start + AgentOffset, Apex, FQuat::Identity, ECC_Pawn, Capsule, QueryParams)
+				&& !World->SweepTestByChannel(Apex, End + AgentOffset, FQuat::Identity, ECC_Pawn, Capsule, QueryParams)
+				&& IsWorthLink(Start, End))
+			{
+				AddLink(Start, End, EShooterTraversalType::Jetpack);
+				NumAdded++;
+			}
+		}
+	}
+
+	// wall run: along longer side of each "Wall" blocking volume, both faces and directions
+	// endpoints stay within reach of UShooterCharacterMovement::IsInAirNearWall (collision radius + 30)
+	const FVector ProjectExtent(AgentRadius * 4.0f, AgentRadius * 4.0f, MaxJetpackHeight);
+	const float WallOffset = AgentRadius + 30.0f;
+	for (TActorIterator<ABlockingVolume> It(World); It; ++It)
+	{
+		const ABlockingVolume* Wall = *It;
+		if (!Wall->ActorHasTag("Wall"))
+		{
+			continue;
+		}
+
+		const FBox LocalBox = Wall->CalculateComponentsBoundingBoxInLocalSpace();
+		if (!LocalBox.IsValid)
+		{
+			continue;
+		}
+
+		const FVector Center = LocalBox.GetCenter();
+		const FVector Extent = LocalBox.GetExtent();
+		const bool bAlongX = Extent.X >= Extent.Y;
+		const FVector LongAxis = bAlongX ? FVector(Extent.X - AgentRadius, 0.0f, 0.0f) : FVector(0.0f, Extent.Y - AgentRadius, 0.0f);
+		const FVector SideAxis = bAlongX ? FVector(0.0f, Extent.Y, 0.0f) : FVector(Extent.X, 0.0f, 0.0f);
+
+		for (const float Side : { -1.0f, 1.0f })
+		{
+			// scale can be non uniform, offset from face is applied in world space
+			const FVector SideDir = Wall->GetActorTransform().TransformVector(SideAxis * Side).GetSafeNormal();
+			const FVector WallStart = Wall->GetActorTransform().TransformPosition(Center - LongAxis + SideAxis * Side) + SideDir * WallOffset;
+			const FVector WallEnd = Wall->GetActorTransform().TransformPosition(Center + LongAxis + SideAxis * Side) + SideDir * WallOffset;
+
+			FNavLocation Start, End;
+			if (NavSys->ProjectPointToNavigation(WallStart, Start, ProjectExtent, NavMesh)
+				&& NavSys->ProjectPointToNavigation(WallEnd, End, ProjectExtent, NavMesh)
+				&& IsWorthLink(Start.Location, End.Location))
+			{
+				AddLink(Start.Location, End.Location, EShooterTraversalType::WallRun);
+				AddLink(End.Location, Start.Location, EShooterTraversalType::WallRun);
+			}
+		}
+	}
+
+	// teleport: forward until first obstacle, like movement component does, then fall to navmesh
+	TSet<FIntPoint> TeleportCells;
+	for (const FVector& Start : Samples)
+	{
+		const FIntPoint Cell(FMath::FloorToInt(Start.X / TeleportSpacing), FMath::FloorToInt(Start.Y / TeleportSpacing));
+		if (TeleportCells.Contains(Cell))
+		{
+			continue;
+		}
+		TeleportCells.Add(Cell);
+
+		int32 NumAdded = 0;
+		for (int32 DirIdx = 0; DirIdx < 8 && NumAdded < MaxLinksPerSample; DirIdx++)
+		{
+			const FVector Dir = FRotator(0.0f, DirIdx * 45.0f, 0.0f).Vector();
+
+			FHitResult Hit;
+			const FVector TeleportStart = Start + AgentOffset;
+			FVector TeleportEnd = TeleportStart + Dir * TeleportDistance;
+			if (World->SweepSingleByChannel(Hit, TeleportStart, TeleportEnd, FQuat::Identity, ECC_Pawn, Capsule, QueryParams))
+			{
+				TeleportEnd = Hit.Location;
+			}
+
+			FNavLocation End;
+			if (FVector::DistSquared2D(TeleportStart, TeleportEnd) > FMath::Square(TeleportDistance * 0.5f)
+				&& NavSys->ProjectPointToNavigation(TeleportEnd, End, ProjectExtent, NavMesh)
+				&& End.Location.Z <= TeleportEnd.Z
+				&& IsWorthLink(Start, End.Location))
+			{
+				AddLink(Start, End.Location, EShooterTraversalType::Teleport);
+				NumAdded++;
+			}
+		}
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Baked %d traversal links from %d navmesh samples"), Links.Num(), Samples.Num());
+
+	UpdateNavLinks();
+	FNavigationSystem::UpdateActorData(*this);
+#endif // WITH_RECAST
+}
+
+bool AShooterTraversalLinks::IsWorthLink(const FVector& Start, const FVector& End) const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : NULL;
+	if (NavData == NULL)
+	{
+		return false;
+	}
+
+	// walk only, links baked before must not shorten the path
+	FSharedNavQueryFilter WalkFilter = NavData->GetDefaultQueryFilter()->GetCopy();
+	WalkFilter->SetExcludedArea(NavData->GetAreaID(UShooterNavArea_Jetpack::StaticClass()));
+	WalkFilter->SetExcludedArea(NavData->GetAreaID(UShooterNavArea_WallRun::StaticClass()));
+	WalkFilter->SetExcludedArea(NavData->GetAreaID(UShooterNavArea_Teleport::StaticClass()));
+
+	const FPathFindingResult Result = NavSys->FindPathSync(FPathFindingQuery(this, *NavData, Start, End, WalkFilter));
+	if (!Result.IsSuccessful() || Result.IsPartial() || !Result.Path.IsValid())
+	{
+		return true;
+	}
+
+	return Result.Path->GetLength() >= FVector::Dist(Start, End) * MinDetourRatio;
+}
+
+void AShooterTraversalLinks::AddLink(const FVector& Start, const FVector& End, EShooterTraversalType Type)
+{
+	FShooterTraversalLink Link;
+	Link.Start = GetActorTransform().InverseTransformPosition(Start);
+	Link.End = GetActorTransform().InverseTransformPosition(End);
+	Link.Type = Type;
+	Links.Add(Link);
+}
+
+#endif // WITH_EDITOR
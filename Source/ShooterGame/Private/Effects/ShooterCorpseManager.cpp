@@ -0,0 +1,284 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Effects/ShooterCorpseManager.h"
+#include "Components/PoseableMeshComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Corpse Manager"), STAT_ShooterCorpseManager, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corpses Simulated"), STAT_ShooterCorpsesSimulated, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corpses Frozen"), STAT_ShooterCorpsesFrozen, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Corpse Posed Meshes"), STAT_ShooterCorpsePosedMeshes, STATGROUP_ShooterGame);
+
+int32 CVar_ShooterCorpses_MaxCorpses = 12;
+static FAutoConsoleVariableRef CVarShooterCorpsesMaxCorpses(TEXT("ShooterCorpses.MaxCorpses"), CVar_ShooterCorpses_MaxCorpses, TEXT("Max number of corpses in world, oldest one is faded out quickly above it"), ECVF_Default );
+
+float CVar_ShooterCorpses_FreezeDistance = 3000.f;
+static FAutoConsoleVariableRef CVarShooterCorpsesFreezeDistance(TEXT("ShooterCorpses.FreezeDistance"), CVar_ShooterCorpses_FreezeDistance, TEXT("Ragdolls further from all local cameras are frozen right away"), ECVF_Default );
+
+float CVar_ShooterCorpses_MaxSimulationTime = 4.f;
+static FAutoConsoleVariableRef CVarShooterCorpsesMaxSimulationTime(TEXT("ShooterCorpses.MaxSimulationTime"), CVar_ShooterCorpses_MaxSimulationTime, TEXT("Ragdolls are frozen after this time even if they didn't settle"), ECVF_Default );
+
+float CVar_ShooterCorpses_LifeTime = 10.f;
+static FAutoConsoleVariableRef CVarShooterCorpsesLifeTime(TEXT("ShooterCorpses.LifeTime"), CVar_ShooterCorpses_LifeTime, TEXT("Time after death when corpse starts fading"), ECVF_Default );
+
+float CVar_ShooterCorpses_FadeTime = 1.f;
+static FAutoConsoleVariableRef CVarShooterCorpsesFadeTime(TEXT("ShooterCorpses.FadeTime"), CVar_ShooterCorpses_FadeTime, TEXT("Time corpse sinks out of view when it expires"), ECVF_Default );
+
+float CVar_ShooterCorpses_FastFadeTime = 0.25f;
+static FAutoConsoleVariableRef CVarShooterCorpsesFastFadeTime(TEXT("ShooterCorpses.FastFadeTime"), CVar_ShooterCorpses_FastFadeTime, TEXT("Time corpse sinks out of view when removed over cap"), ECVF_Default );
+
+float CVar_ShooterCorpses_UpdateInterval = 0.1f;
+static FAutoConsoleVariableRef CVarShooterCorpsesUpdateInterval(TEXT("ShooterCorpses.UpdateInterval"), CVar_ShooterCorpses_UpdateInterval, TEXT("Time between freeze and cap checks, fading is updated every frame"), ECVF_Default );
+
+UShooterCorpseManager::UShooterCorpseManager()
+{
+	LastUpdateTime = -MAX_FLT;
+}
+
+UShooterCorpseManager* UShooterCorpseManager::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterCorpseManager>() : NULL;
+}
+
+void UShooterCorpseManager::Deinitialize()
+{
+	for (UPoseableMeshComponent* PosedMesh : PosedMeshes)
+	{
+		if (PosedMesh)
+		{
+			PosedMesh->DestroyComponent();
+		}
+	}
+
+	DEC_DWORD_STAT_BY(STAT_ShooterCorpsePosedMeshes, PosedMeshes.Num());
+	PosedMeshes.Empty();
+	FreePosedMeshes.Empty();
+	Corpses.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UShooterCorpseManager::IsTickable() const
+{
+	return Corpses.Num() > 0 && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UShooterCorpseManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterCorpseManager, STATGROUP_Tickables);
+}
+
+UWorld* UShooterCorpseManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+bool UShooterCorpseManager::RegisterCorpse(AShooterCharacter* Character)
+{
+	if (Character == NULL || Character->GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+
+	// manager decides when it goes away
+	Character->SetLifeSpan(0.0f);
+
+	FCorpse NewCorpse;
+	NewCorpse.Character = Character;
+	NewCorpse.PosedMesh = NULL;
+	NewCorpse.DeathTime = GetWorld()->GetTimeSeconds();
+	NewCorpse.FadeStartTime = -1.0f;
+	NewCorpse.FadeDuration = 0.0f;
+	NewCorpse.FadeStartLocation = FVector::ZeroVector;
+	Corpses.Add(NewCorpse);
+
+	// check cap right away
+	LastUpdateTime = -MAX_FLT;
+	return true;
+}
+
+void UShooterCorpseManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCorpseManager);
+
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	const bool bWantsUpdate = (GameTime - LastUpdateTime >= CVar_ShooterCorpses_UpdateInterval);
+	if (bWantsUpdate)
+	{
+		LastUpdateTime = GameTime;
+	}
+
+	int32 NumActive = 0;
+	int32 NumSimulated = 0;
+	for (int32 CorpseIdx = Corpses.Num() - 1; CorpseIdx >= 0; CorpseIdx--)
+	{
+		FCorpse& Corpse = Corpses[CorpseIdx];
+		AShooterCharacter* Character = Corpse.Character.Get();
+		if (Character == NULL && Corpse.PosedMesh == NULL)
+		{
+			// destroyed by someone else
+			Corpses.RemoveAt(CorpseIdx, 1, false);
+			continue;
+		}
+
+		if (Corpse.FadeStartTime >= 0.0f)
+		{
+			const float FadeAlpha = (GameTime - Corpse.FadeStartTime) / FMath::Max(Corpse.FadeDuration, KINDA_SMALL_NUMBER);
+			if (FadeAlpha >= 1.0f || Corpse.PosedMesh == NULL)
+			{
+				if (Corpse.PosedMesh)
+				{
+					// drop materials of dead character, they may be its dynamic instances
+					Corpse.PosedMesh->SetVisibility(false);
+					Corpse.PosedMesh->EmptyOverrideMaterials();
+					FreePosedMeshes.Add(Corpse.PosedMesh);
+				}
+				Corpses.RemoveAt(CorpseIdx, 1, false);
+				continue;
+			}
+
+			const float SinkDepth = Corpse.PosedMesh->Bounds.BoxExtent.Z * 2.0f;
+			Corpse.PosedMesh->SetWorldLocation(Corpse.FadeStartLocation - FVector(0.0f, 0.0f, SinkDepth * FadeAlpha));
+			continue;
+		}
+
+		NumActive++;
+
+		if (!bWantsUpdate)
+		{
+			continue;
+		}
+
+		if (GameTime - Corpse.DeathTime >= CVar_ShooterCorpses_LifeTime)
+		{
+			StartFade(Corpse, CVar_ShooterCorpses_FadeTime);
+			continue;
+		}
+
+		if (Character)
+		{
+			// settled, far from everyone or simulating too long
+			USkeletalMeshComponent* Mesh = Character->GetMesh();
+			const bool bSettled = Mesh && Mesh->IsSimulatingPhysics() && !Mesh->IsAnyRigidBodyAwake();
+			const bool bTimedOut = GameTime - Corpse.DeathTime >= CVar_ShooterCorpses_MaxSimulationTime;
+			if ((bSettled || bTimedOut || !IsNearLocalViewer(Character->GetActorLocation(), CVar_ShooterCorpses_FreezeDistance)) && FreezeCorpse(Corpse))
+			{
+				continue;
+			}
+
+			NumSimulated++;
+		}
+	}
+
+	// oldest corpses over cap go away quickly
+	if (bWantsUpdate)
+	{
+		for (int32 CorpseIdx = 0; CorpseIdx < Corpses.Num() && NumActive > CVar_ShooterCorpses_MaxCorpses; CorpseIdx++)
+		{
+			FCorpse& Corpse = Corpses[CorpseIdx];
+			if (Corpse.FadeStartTime < 0.0f)
+			{
+				if (Corpse.Character.IsValid())
+				{
+					NumSimulated--;
+				}
+
+				StartFade(Corpse, CVar_ShooterCorpses_FastFadeTime);
+				NumActive--;
+			}
+		}
+
+		SET_DWORD_STAT(STAT_ShooterCorpsesSimulated, NumSimulated);
+		SET_DWORD_STAT(STAT_ShooterCorpsesFrozen, NumActive - NumSimulated);
+	}
+}
+
+bool UShooterCorpseManager::FreezeCorpse(FCorpse& Corpse)
+{
+	AShooterCharacter* Character = Corpse.Character.Get();
+	if (Character == NULL)
+	{
+		return Corpse.PosedMesh != NULL;
+	}
+
+	// client can't destroy dead character until it's torn off
+	if (Character->GetLocalRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+	if (Mesh && Mesh->SkeletalMesh)
+	{
+		UPoseableMeshComponent* PosedMesh = (FreePosedMeshes.Num() > 0) ? FreePosedMeshes.Pop(false) : NULL;
+		if (PosedMesh == NULL)
+		{
+			PosedMesh = NewObject<UPoseableMeshComponent>(GetWorld()->GetWorldSettings());
+			PosedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			PosedMesh->bReceivesDecals = false;
+			PosedMesh->RegisterComponentWithWorld(GetWorld());
+			PosedMesh->SetComponentTickEnabled(false);
+			PosedMeshes.Add(PosedMesh);
+			INC_DWORD_STAT(STAT_ShooterCorpsePosedMeshes);
+		}
+
+		PosedMesh->SetSkeletalMesh(Mesh->SkeletalMesh);
+		PosedMesh->SetWorldTransform(Mesh->GetComponentTransform());
+		for (int32 MaterialIdx = 0; MaterialIdx < Mesh->GetNumMaterials(); MaterialIdx++)
+		{
+			PosedMesh->SetMaterial(MaterialIdx, Mesh->GetMaterial(MaterialIdx));
+		}
+		PosedMesh->CopyPoseFromSkeletalComponent(Mesh);
+		PosedMesh->SetVisibility(true);
+
+		Corpse.PosedMesh = PosedMesh;
+	}
+
+	Corpse.Character = NULL;
+	Character->Destroy();
+
+	return Corpse.PosedMesh != NULL;
+}
+
+void UShooterCorpseManager::StartFade(FCorpse& Corpse, float Duration)
+{
+	// freezing may destroy character without making posed mesh (no skeletal mesh)
+	if (Corpse.Character.IsValid() && !FreezeCorpse(Corpse) && Corpse.Character.IsValid())
+	{
+		// not torn off yet, just hide it and let its own lifespan clean up
+		AShooterCharacter* Character = Corpse.Character.Get();
+		Character->SetActorHiddenInGame(true);
+		Character->SetLifeSpan(1.0f);
+		Corpse.Character = NULL;
+	}
+
+	Corpse.FadeStartTime = GetWorld()->GetTimeSeconds();
+	Corpse.FadeDuration = Duration;
+	Corpse.FadeStartLocation = Corpse.PosedMesh ? Corpse.PosedMesh->GetComponentLocation() : FVector::ZeroVector;
+}
+
+bool UShooterCorpseManager::IsNearLocalViewer(const FVector& Location, float MaxDistance) const
+{
+	bool bHasLocalViewer = false;
+	const float MaxDistanceSq = FMath::Square(MaxDistance);
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC == NULL || !PC->IsLocalController() || PC->PlayerCameraManager == NULL)
+		{
+			continue;
+		}
+
+		bHasLocalViewer = true;
+
+		if (FVector::DistSquared(PC->PlayerCameraManager->GetCameraLocation(), Location) <= MaxDistanceSq)
+		{
+			return true;
+		}
+	}
+
+	// nobody to measure against, keep simulating
+	return !bHasLocalViewer;
+}
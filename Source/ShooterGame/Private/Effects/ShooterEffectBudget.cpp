@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Effects/ShooterEffectBudget.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Components/DecalComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effects Spawned"), STAT_ShooterEffectsSpawned, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effects Culled"), STAT_ShooterEffectsCulled, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effects Over Budget"), STAT_ShooterEffectsOverBudget, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impacts Merged"), STAT_ShooterImpactsMerged, STATGROUP_ShooterGame);
+
+int32 CVar_ShooterFX_MaxEmittersPerFrame = 8;
+static FAutoConsoleVariableRef CVarShooterFXMaxEmittersPerFrame(TEXT("ShooterFX.MaxEmittersPerFrame"), CVar_ShooterFX_MaxEmittersPerFrame, TEXT("Max impact/explosion emitters spawned in a single frame"), ECVF_Default );
+
+int32 CVar_ShooterFX_MaxDecalsPerFrame = 4;
+static FAutoConsoleVariableRef CVarShooterFXMaxDecalsPerFrame(TEXT("ShooterFX.MaxDecalsPerFrame"), CVar_ShooterFX_MaxDecalsPerFrame, TEXT("Max decals spawned in a single frame"), ECVF_Default );
+
+int32 CVar_ShooterFX_MaxSoundsPerFrame = 8;
+static FAutoConsoleVariableRef CVarShooterFXMaxSoundsPerFrame(TEXT("ShooterFX.MaxSoundsPerFrame"), CVar_ShooterFX_MaxSoundsPerFrame, TEXT("Max one-shot sounds started in a single frame"), ECVF_Default );
+
+int32 CVar_ShooterFX_MaxActiveDecals = 64;
+static FAutoConsoleVariableRef CVarShooterFXMaxActiveDecals(TEXT("ShooterFX.MaxActiveDecals"), CVar_ShooterFX_MaxActiveDecals, TEXT("Max decals alive at once, oldest one is removed when exceeded"), ECVF_Default );
+
+float CVar_ShooterFX_CullDistance = 8000.f;
+static FAutoConsoleVariableRef CVarShooterFXCullDistance(TEXT("ShooterFX.CullDistance"), CVar_ShooterFX_CullDistance, TEXT("Max distance (not squared) from local viewer to spawn emitters and decals at"), ECVF_Default );
+
+float CVar_ShooterFX_MinScreenSize = 0.002f;
+static FAutoConsoleVariableRef CVarShooterFXMinScreenSize(TEXT("ShooterFX.MinScreenSize"), CVar_ShooterFX_MinScreenSize, TEXT("Min projected size (fraction of half screen) of emitters and decals"), ECVF_Default );
+
+float CVar_ShooterFX_MergeDistance = 30.f;
+static FAutoConsoleVariableRef CVarShooterFXMergeDistance(TEXT("ShooterFX.MergeDistance"), CVar_ShooterFX_MergeDistance, TEXT("Impacts closer than this to a recent one are merged into it"), ECVF_Default );
+
+float CVar_ShooterFX_MergeTime = 0.1f;
+static FAutoConsoleVariableRef CVarShooterFXMergeTime(TEXT("ShooterFX.MergeTime"), CVar_ShooterFX_MergeTime, TEXT("Time window (seconds) for merging near-duplicate impacts"), ECVF_Default );
+
+UShooterEffectBudget::UShooterEffectBudget()
+{
+	BudgetFrame = 0;
+	FMemory::Memzero(SpawnedThisFrame);
+}
+
+UShooterEffectBudget* UShooterEffectBudget::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return World ? World->GetSubsystem<UShooterEffectBudget>() : NULL;
+}
+
+bool UShooterEffectBudget::ShouldSpawnImpact(const FVector& Location)
+{
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+	const float MergeDistSq = FMath::Square(CVar_ShooterFX_MergeDistance);
+
+	// drop impacts outside merge window, they are sorted by time
+	int32 NumExpired = 0;
+	while (NumExpired < RecentImpacts.Num() && TimeSeconds - RecentImpacts[NumExpired].Time > CVar_ShooterFX_MergeTime)
+	{
+		NumExpired++;
+	}
+	RecentImpacts.RemoveAt(0, NumExpired, false);
+
+	for (const FRecentImpact& Impact : RecentImpacts)
+	{
+		if (FVector::DistSquared(Impact.Location, Location) < MergeDistSq)
+		{
+			INC_DWORD_STAT(STAT_ShooterImpactsMerged);
+			return false;
+		}
+	}
+
+	FRecentImpact NewImpact;
+	NewImpact.Location = Location;
+	NewImpact.Time = TimeSeconds;
+	RecentImpacts.Add(NewImpact);
+
+	return true;
+}
+
+UParticleSystemComponent* UShooterEffectBudget::SpawnEmitterAtLocation(UParticleSystem* EmitterTemplate, const FVector& Location, const FRotator& Rotation, float EffectRadius)
+{
+	if (EmitterTemplate == NULL)
+	{
+		return NULL;
+	}
+
+	if (!IsRelevantForLocalViewers(Location, EffectRadius, CVar_ShooterFX_CullDistance))
+	{
+		INC_DWORD_STAT(STAT_ShooterEffectsCulled);
+		return NULL;
+	}
+
+	if (!ConsumeFrameBudget(EShooterEffectType::Emitter))
+	{
+		return NULL;
+	}
+
+	return UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), EmitterTemplate, Location, Rotation);
+}
+
+UDecalComponent* UShooterEffectBudget::SpawnDecalAttached(UMaterialInterface* DecalMaterial, const FVector& DecalSize, USceneComponent* AttachToComponent, FName AttachPointName, const FVector& Location, const FRotator& Rotation, float LifeSpan)
+{
+	if (DecalMaterial == NULL)
+	{
+		return NULL;
+	}
+
+	if (!IsRelevantForLocalViewers(Location, DecalSize.GetMax(), CVar_ShooterFX_CullDistance))
+	{
+		INC_DWORD_STAT(STAT_ShooterEffectsCulled);
+		return NULL;
+	}
+
+	if (!ConsumeFrameBudget(EShooterEffectType::Decal))
+	{
+		return NULL;
+	}
+
+	// recycle oldest decals when over the concurrent limit
+	ActiveDecals.RemoveAll([](const TWeakObjectPtr<UDecalComponent>& Decal) { return !Decal.IsValid(); });
+	while (ActiveDecals.Num() > 0 && ActiveDecals.Num() >= CVar_ShooterFX_MaxActiveDecals)
+	{
+		UDecalComponent* OldestDecal = ActiveDecals[0].Get();
+		ActiveDecals.RemoveAt(0, 1, false);
+		OldestDecal->DestroyComponent();
+	}
+
+	// component may be unknown when hit was reconstructed from replicated data
+	UDecalComponent* DecalComp = AttachToComponent ?
+		UGameplayStatics::SpawnDecalAttached(DecalMaterial, DecalSize, AttachToComponent, AttachPointName, Location, Rotation, EAttachLocation::KeepWorldPosition, LifeSpan) :
+		UGameplayStatics::SpawnDecalAtLocation(GetWorld(), DecalMaterial, DecalSize, Location, Rotation, LifeSpan);
+	if (DecalComp)
+	{
+		ActiveDecals.Add(DecalComp);
+	}
+
+	return DecalComp;
+}
+
+void UShooterEffectBudget::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location)
+{
+	if (Sound == NULL)
+	{
+		return;
+	}
+
+	// sounds are culled by their own attenuation range, screen size doesn't matter
+	if (!IsRelevantForLocalViewers(Location, 0.0f, Sound->GetMaxDistance()))
+	{
+		INC_DWORD_STAT(STAT_ShooterEffectsCulled);
+		return;
+	}
+
+	if (ConsumeFrameBudget(EShooterEffectType::Sound))
+	{
+		UGameplayStatics::PlaySoundAtLocation(GetWorld(), Sound, Location);
+	}
+}
+
+bool UShooterEffectBudget::ConsumeFrameBudget(EShooterEffectType::Type Type)
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		FMemory::Memzero(SpawnedThisFrame);
+	}
+
+	int32 MaxPerFrame = 0;
+	switch (Type)
+	{
+		case EShooterEffectType::Emitter:	MaxPerFrame = CVar_ShooterFX_MaxEmittersPerFrame; break;
+		case EShooterEffectType::Decal:		MaxPerFrame = CVar_ShooterFX_MaxDecalsPerFrame; break;
+		case EShooterEffectType::Sound:		MaxPerFrame = CVar_ShooterFX_MaxSoundsPerFrame; break;
+		default:							break;
+	}
+
+	if (SpawnedThisFrame[Type] >= MaxPerFrame)
+	{
+		INC_DWORD_STAT(STAT_ShooterEffectsOverBudget);
+		return false;
+	}
+
+	SpawnedThisFrame[Type]++;
+	INC_DWORD_STAT(STAT_ShooterEffectsSpawned);
+	return true;
+}
+
+bool UShooterEffectBudget::IsRelevantForLocalViewers(const FVector& Location, float EffectRadius, float MaxDistance) const
+{
+	bool bHasLocalViewer = false;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC == NULL || !PC->IsLocalController() || PC->PlayerCameraManager == NULL)
+		{
+			continue;
+		}
+
+		bHasLocalViewer = true;
+
+		const float Distance = FVector::Dist(PC->PlayerCameraManager->GetCameraLocation(), Location);
+		if (Distance > MaxDistance)
+		{
+			continue;
+		}
+
+		if (EffectRadius <= 0.0f)
+		{
+			return true;
+		}
+
+		// projected size as a fraction of half screen width
+		const float HalfFOVTan = FMath::Tan(FMath::DegreesToRadians(PC->PlayerCameraManager->GetFOVAngle() * 0.5f));
+		const float ScreenSize = EffectRadius / FMath::Max(Distance * HalfFOVTan, 1.0f);
+		if (ScreenSize >= CVar_ShooterFX_MinScreenSize)
+		{
+			return true;
+		}
+	}
+
+	// nobody to cull against (e.g. no camera yet), don't hide anything
+	return !bHasLocalViewer;
+}
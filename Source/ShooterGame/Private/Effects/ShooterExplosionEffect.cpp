@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "ShooterExplosionEffect.h"
+#include "Effects/ShooterEffectBudget.h"
 
 AShooterExplosionEffect::AShooterExplosionEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -25,14 +26,20 @@ void AShooterExplosionEffect::BeginPlay()
 {
 	Super::BeginPlay();
 
+	UShooterEffectBudget* EffectBudget = UShooterEffectBudget::Get(this);
+	if (EffectBudget == NULL)
+	{
+		return;
+	}
+
 	if (ExplosionFX)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(this, ExplosionFX, GetActorLocation(), GetActorRotation());
+		EffectBudget->SpawnEmitterAtLocation(ExplosionFX, GetActorLocation(), GetActorRotation(), ExplosionLight->AttenuationRadius);
 	}
 
 	if (ExplosionSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ExplosionSound, GetActorLocation());
+		EffectBudget->PlaySoundAtLocation(ExplosionSound, GetActorLocation());
 	}
 
 	if (Decal.DecalMaterial)
@@ -40,10 +47,9 @@ void AShooterExplosionEffect::BeginPlay()
 		FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
 		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
 
-		UGameplayStatics::SpawnDecalAttached(Decal.DecalMaterial, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f),
+		EffectBudget->SpawnDecalAttached(Decal.DecalMaterial, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f),
 			SurfaceHit.Component.Get(), SurfaceHit.BoneName,
-			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
-			Decal.LifeSpan);
+			SurfaceHit.ImpactPoint, RandomDecalRotation, Decal.LifeSpan);
 	}
 }
 
@@ -2,31 +2,39 @@
 
 #include "ShooterGame.h"
 #include "ShooterImpactEffect.h"
+#include "Effects/ShooterEffectBudget.h"
 
 AShooterImpactEffect::AShooterImpactEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	SetAutoDestroyWhenFinished(true);
+	SurfaceType = SurfaceType_Default;
 }
 
 void AShooterImpactEffect::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
+	UShooterEffectBudget* EffectBudget = UShooterEffectBudget::Get(this);
+	if (EffectBudget == NULL)
+	{
+		return;
+	}
+
 	UPhysicalMaterial* HitPhysMat = SurfaceHit.PhysMaterial.Get();
-	EPhysicalSurface HitSurfaceType = UPhysicalMaterial::DetermineSurfaceType(HitPhysMat);
+	EPhysicalSurface HitSurfaceType = HitPhysMat ? UPhysicalMaterial::DetermineSurfaceType(HitPhysMat) : SurfaceType.GetValue();
 
 	// show particles
 	UParticleSystem* ImpactFX = GetImpactFX(HitSurfaceType);
 	if (ImpactFX)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(this, ImpactFX, GetActorLocation(), GetActorRotation());
+		EffectBudget->SpawnEmitterAtLocation(ImpactFX, GetActorLocation(), GetActorRotation(), DefaultDecal.DecalSize);
 	}
 
 	// play sound
 	USoundCue* ImpactSound = GetImpactSound(HitSurfaceType);
 	if (ImpactSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
+		EffectBudget->PlaySoundAtLocation(ImpactSound, GetActorLocation());
 	}
 
 	if (DefaultDecal.DecalMaterial)
@@ -34,10 +42,9 @@ void AShooterImpactEffect::PostInitializeComponents()
 		FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
 		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
 
-		UGameplayStatics::SpawnDecalAttached(DefaultDecal.DecalMaterial, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize),
+		EffectBudget->SpawnDecalAttached(DefaultDecal.DecalMaterial, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize),
 			SurfaceHit.Component.Get(), SurfaceHit.BoneName,
-			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
-			DefaultDecal.LifeSpan);
+			SurfaceHit.ImpactPoint, RandomDecalRotation, DefaultDecal.LifeSpan);
 	}
 }
 
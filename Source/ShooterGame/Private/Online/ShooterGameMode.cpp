@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "ShooterGameInstance.h"
+#include "ShooterEngine.h"
 #include "UI/ShooterHUD.h"
 #include "Player/ShooterSpectatorPawn.h"
 #include "Player/ShooterDemoSpectator.h"
@@ -10,7 +11,30 @@
 #include "Online/ShooterGameSession.h"
 #include "Bots/ShooterAIController.h"
 #include "ShooterTeamStart.h"
+#include "Online/ShooterSpawnPoints.h"
+#include "Player/ShooterPawnPool.h"
+#include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterDroppedAmmoPool.h"
+#include "Bots/ShooterTacticalPoints.h"
 
+DECLARE_CYCLE_STAT(TEXT("Choose Player Start"), STAT_ShooterChoosePlayerStart, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Respawn Queue"), STAT_ShooterRespawnQueue, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Restart Player"), STAT_ShooterRestartPlayer, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Respawns"), STAT_ShooterQueuedRespawns, STATGROUP_ShooterGame);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Respawn Batch Frame Max (ms)"), STAT_ShooterRespawnBatchFrameMax, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Match Reset"), STAT_ShooterMatchReset, STATGROUP_ShooterGame);
+
+float CVar_ShooterSpawn_DangerTolerance = 0.5f;
+static FAutoConsoleVariableRef CVarShooterSpawnDangerTolerance(TEXT("ShooterSpawn.DangerTolerance"), CVar_ShooterSpawn_DangerTolerance, TEXT("Spawns this much more dangerous than safest one are still picked randomly"), ECVF_Default );
+
+int32 CVar_ShooterPawnPool_NumPlayerPawns = 4;
+static FAutoConsoleVariableRef CVarShooterPawnPoolNumPlayerPawns(TEXT("ShooterPawnPool.NumPlayerPawns"), CVar_ShooterPawnPool_NumPlayerPawns, TEXT("Number of player pawns kept ready in pawn pool, bot pawns follow max bots"), ECVF_Default );
+
+float CVar_ShooterRespawn_Budget = 4.f;
+static FAutoConsoleVariableRef CVarShooterRespawnBudget(TEXT("ShooterRespawn.Budget"), CVar_ShooterRespawn_Budget, TEXT("Time in ms spent per frame on restarting players queued at match start, at least one is always restarted"), ECVF_Default );
+
+int32 CVar_ShooterMatch_ResetInPlace = 1;
+static FAutoConsoleVariableRef CVarShooterMatchResetInPlace(TEXT("ShooterMatch.ResetInPlace"), CVar_ShooterMatch_ResetInPlace, TEXT("Restart match by resetting actors in current world instead of server travel, clients stay connected"), ECVF_Default );
 
 AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -31,6 +55,13 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
+	bQueueRespawns = false;
+	RespawnBatchStartTime = 0.0;
+	RespawnBatchMaxFrameTime = 0.0;
+	RespawnBatchNumFrames = 0;
+	RespawnBatchNumPlayers = 0;
+	MatchEndTime = 0.0;
+	MatchResetDuration = 0.0;
 	bUseSeamlessTravel = FParse::Param(FCommandLine::Get(), TEXT("NoSeamlessTravel")) ? false : true;
 }
 
@@ -59,6 +90,12 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	{
 		bPauseable = false;
 	}
+
+	// seamless travel can't load map into instanced package of extra match
+	if (UShooterEngine::IsExtraMatchWorld(GetWorld()))
+	{
+		bUseSeamlessTravel = false;
+	}
 }
 
 void AShooterGameMode::SetAllowBots(bool bInAllowBots, int32 InMaxBots)
@@ -80,6 +117,34 @@ void AShooterGameMode::PreInitializeComponents()
 	GetWorldTimerManager().SetTimer(TimerHandle_DefaultTimer, this, &AShooterGameMode::DefaultTimer, GetWorldSettings()->GetEffectiveTimeDilation(), true);
 }
 
+void AShooterGameMode::StartPlay()
+{
+	UShooterSpawnPoints* SpawnPoints = UShooterSpawnPoints::Get(this);
+	if (SpawnPoints)
+	{
+		SpawnPoints->CacheStarts();
+	}
+
+	UShooterPawnPool* PawnPool = UShooterPawnPool::Get(this);
+	if (PawnPool && GetNetMode() != NM_Client)
+	{
+		PawnPool->Prewarm(*DefaultPawnClass, CVar_ShooterPawnPool_NumPlayerPawns);
+		if (bAllowBots)
+		{
+			PawnPool->Prewarm(*BotPawnClass, MaxBots);
+		}
+	}
+
+	// sample tactical points while loading, not on first bot query mid match
+	UShooterTacticalPoints* TacticalPoints = UShooterTacticalPoints::Get(this);
+	if (TacticalPoints && bAllowBots && GetNetMode() != NM_Client)
+	{
+		TacticalPoints->BuildPoints();
+	}
+
+	Super::StartPlay();
+}
+
 void AShooterGameMode::DefaultTimer()
 {
 	// don't update timers for Play In Editor mode, it's not real match
@@ -162,12 +227,19 @@ void AShooterGameMode::HandleMatchIsWaitingToStart()
 void AShooterGameMode::HandleMatchHasStarted()
 {
 	bNeedsBotCreation = true;
+
+	// everyone restarts now, spread it over next frames
+	bQueueRespawns = true;
 	Super::HandleMatchHasStarted();
 
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
 	MyGameState->RemainingTime = RoundTime;	
 	StartBots();	
 
+	bQueueRespawns = false;
+	AssignRespawnStarts();
+	ProcessRespawnQueue();
+
 	// notify players
 	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 	{
@@ -203,7 +275,7 @@ void AShooterGameMode::FinishMatch()
 
 		// lock all pawns
 		// pawns are not marked as keep for seamless travel, so we will create new pawns on the next match rather than
-		// turning these back on.
+		// turning these back on. In place reset parks alive ones in pawn pool instead.
 		for (APawn* Pawn : TActorRange<APawn>(GetWorld()))
 		{
 			Pawn->TurnOff();
@@ -211,6 +283,7 @@ void AShooterGameMode::FinishMatch()
 
 		// set up to restart the match
 		MyGameState->RemainingTime = TimeBetweenMatches;
+		MatchEndTime = FPlatformTime::Seconds();
 	}
 }
 
@@ -366,8 +439,33 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController_Implementation(AContr
 	return Super::GetDefaultPawnClassForController_Implementation(InController);
 }
 
+APawn* AShooterGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
+{
+	UShooterPawnPool* PawnPool = UShooterPawnPool::Get(this);
+	UClass* PawnClass = GetDefaultPawnClassForController(NewPlayer);
+	if (PawnPool && PawnClass && PawnClass->IsChildOf<AShooterCharacter>())
+	{
+		AShooterCharacter* PooledPawn = PawnPool->AcquirePawn(PawnClass, SpawnTransform);
+		if (PooledPawn)
+		{
+			return PooledPawn;
+		}
+	}
+
+	return Super::SpawnDefaultPawnAtTransform_Implementation(NewPlayer, SpawnTransform);
+}
+
 void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 {
+	if (bQueueRespawns && NewPlayer)
+	{
+		PendingRespawns.AddUnique(NewPlayer);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterRestartPlayer);
+
+	PendingRespawns.Remove(NewPlayer);
 	Super::RestartPlayer(NewPlayer);
 
 	AShooterPlayerController* PC = Cast<AShooterPlayerController>(NewPlayer);
@@ -386,49 +484,173 @@ void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 
 AActor* AShooterGameMode::ChoosePlayerStart_Implementation(AController* Player)
 {
-	TArray<APlayerStart*> PreferredSpawns;
+	SCOPE_CYCLE_COUNTER(STAT_ShooterChoosePlayerStart);
+
+	TWeakObjectPtr<APlayerStart> AssignedStart;
+	if (AssignedStarts.RemoveAndCopyValue(Player, AssignedStart) && AssignedStart.IsValid())
+	{
+		return AssignedStart.Get();
+	}
+
+	// don't take starts promised to players still in respawn queue
+	TSet<APlayerStart*> ExcludedStarts;
+	for (const TPair<TWeakObjectPtr<AController>, TWeakObjectPtr<APlayerStart>>& Assigned : AssignedStarts)
+	{
+		if (Assigned.Value.IsValid())
+		{
+			ExcludedStarts.Add(Assigned.Value.Get());
+		}
+	}
+
+	APlayerStart* BestStart = PickPlayerStart(Player, ExcludedStarts);
+	return BestStart ? BestStart : Super::ChoosePlayerStart_Implementation(Player);
+}
+
+APlayerStart* AShooterGameMode::PickPlayerStart(AController* Player, const TSet<APlayerStart*>& ExcludedStarts)
+{
+	UShooterSpawnPoints* SpawnPoints = UShooterSpawnPoints::Get(this);
+	if (SpawnPoints == NULL)
+	{
+		return NULL;
+	}
+
+	SpawnPoints->UpdateDanger();
+
+	// teammates don't make spawn dangerous
+	const AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
+	const AShooterPlayerState* PlayerState = Player ? Cast<AShooterPlayerState>(Player->PlayerState) : NULL;
+	const int32 FriendlyTeam = (MyGameState && MyGameState->NumTeams > 0 && PlayerState) ? PlayerState->GetTeamNum() : INDEX_NONE;
+
+	TArray<TPair<float, APlayerStart*>> PreferredSpawns;
 	TArray<APlayerStart*> FallbackSpawns;
+	float MinDanger = MAX_FLT;
 
-	APlayerStart* BestStart = NULL;
-	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	const TArray<APlayerStart*>& Starts = SpawnPoints->GetStarts();
+	for (int32 StartIdx = 0; StartIdx < Starts.Num(); StartIdx++)
 	{
-		APlayerStart* TestSpawn = *It;
+		APlayerStart* TestSpawn = Starts[StartIdx];
+		if (TestSpawn == NULL)
+		{
+			continue;
+		}
+
 		if (TestSpawn->IsA<APlayerStartPIE>())
 		{
 			// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
-			BestStart = TestSpawn;
-			break;
+			return TestSpawn;
 		}
-		else
+
+		if (!ExcludedStarts.Contains(TestSpawn) && IsSpawnpointAllowed(TestSpawn, Player))
 		{
-			if (IsSpawnpointAllowed(TestSpawn, Player))
+			if (IsSpawnpointPreferred(TestSpawn, Player))
 			{
-				if (IsSpawnpointPreferred(TestSpawn, Player))
-				{
-					PreferredSpawns.Add(TestSpawn);
-				}
-				else
-				{
-					FallbackSpawns.Add(TestSpawn);
-				}
+				const float Danger = SpawnPoints->GetDanger(StartIdx, FriendlyTeam);
+				PreferredSpawns.Add(TPair<float, APlayerStart*>(Danger, TestSpawn));
+				MinDanger = FMath::Min(MinDanger, Danger);
+			}
+			else
+			{
+				FallbackSpawns.Add(TestSpawn);
 			}
 		}
 	}
 
-	
-	if (BestStart == NULL)
+	if (PreferredSpawns.Num() > 0)
 	{
-		if (PreferredSpawns.Num() > 0)
+		// random pick among safest spawns, so players don't always appear in the same spot
+		PreferredSpawns.RemoveAllSwap([MinDanger](const TPair<float, APlayerStart*>& Spawn) { return Spawn.Key > MinDanger + CVar_ShooterSpawn_DangerTolerance; });
+		return PreferredSpawns[FMath::RandHelper(PreferredSpawns.Num())].Value;
+	}
+	else if (FallbackSpawns.Num() > 0)
+	{
+		return FallbackSpawns[FMath::RandHelper(FallbackSpawns.Num())];
+	}
+
+	return NULL;
+}
+
+void AShooterGameMode::AssignRespawnStarts()
+{
+	AssignedStarts.Reset();
+
+	// pawns spawned this frame are not in character grid yet, so starts are matched up front
+	TSet<APlayerStart*> TakenStarts;
+	for (const TWeakObjectPtr<AController>& Controller : PendingRespawns)
+	{
+		if (!Controller.IsValid())
 		{
-			BestStart = PreferredSpawns[FMath::RandHelper(PreferredSpawns.Num())];
+			continue;
 		}
-		else if (FallbackSpawns.Num() > 0)
+
+		APlayerStart* Start = PickPlayerStart(Controller.Get(), TakenStarts);
+		if (Start && !Start->IsA<APlayerStartPIE>())
 		{
-			BestStart = FallbackSpawns[FMath::RandHelper(FallbackSpawns.Num())];
+			TakenStarts.Add(Start);
+			AssignedStarts.Add(Controller, Start);
 		}
 	}
 
-	return BestStart ? BestStart : Super::ChoosePlayerStart_Implementation(Player);
+	RespawnBatchStartTime = FPlatformTime::Seconds();
+	RespawnBatchMaxFrameTime = 0.0;
+	RespawnBatchNumFrames = 0;
+	RespawnBatchNumPlayers = PendingRespawns.Num();
+}
+
+void AShooterGameMode::ProcessRespawnQueue()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterRespawnQueue);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = CVar_ShooterRespawn_Budget / 1000.0;
+	int32 NumRestarted = 0;
+
+	while (PendingRespawns.Num() > 0)
+	{
+		if (NumRestarted > 0 && FPlatformTime::Seconds() - StartTime >= Budget)
+		{
+			break;
+		}
+
+		AController* Controller = PendingRespawns[0].Get();
+		PendingRespawns.RemoveAt(0);
+
+		if (Controller && Controller->GetPawn() == NULL && !Controller->IsPendingKill())
+		{
+			RestartPlayer(Controller);
+			NumRestarted++;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_ShooterQueuedRespawns, NumRestarted);
+
+	const double FrameTime = FPlatformTime::Seconds() - StartTime;
+	RespawnBatchMaxFrameTime = FMath::Max(RespawnBatchMaxFrameTime, FrameTime);
+	RespawnBatchNumFrames++;
+	SET_FLOAT_STAT(STAT_ShooterRespawnBatchFrameMax, RespawnBatchMaxFrameTime * 1000.0f);
+
+	if (PendingRespawns.Num() > 0)
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &AShooterGameMode::ProcessRespawnQueue);
+	}
+	else
+	{
+		AssignedStarts.Reset();
+
+		if (RespawnBatchNumPlayers > 0)
+		{
+			UE_LOG(LogShooter, Log, TEXT("Respawned %d players over %d frames in %.2f ms, max %.2f ms per frame"),
+				RespawnBatchNumPlayers, RespawnBatchNumFrames, (FPlatformTime::Seconds() - RespawnBatchStartTime) * 1000.0, RespawnBatchMaxFrameTime * 1000.0);
+			RespawnBatchNumPlayers = 0;
+		}
+
+		// with server travel game mode is recreated, only in place resets are measured
+		if (MatchEndTime > 0.0)
+		{
+			UE_LOG(LogShooter, Log, TEXT("Between-round downtime %.2f s (match reset %.2f ms)"),
+				FPlatformTime::Seconds() - MatchEndTime, MatchResetDuration * 1000.0);
+			MatchEndTime = 0.0;
+		}
+	}
 }
 
 bool AShooterGameMode::IsSpawnpointAllowed(APlayerStart* SpawnPoint, AController* Player) const
@@ -463,21 +685,10 @@ bool AShooterGameMode::IsSpawnpointPreferred(APlayerStart* SpawnPoint, AControll
 	
 	if (MyPawn)
 	{
-		const FVector SpawnLocation = SpawnPoint->GetActorLocation();
-		for (ACharacter* OtherPawn : TActorRange<ACharacter>(GetWorld()))
+		UShooterSpawnPoints* SpawnPoints = UShooterSpawnPoints::Get(this);
+		if (SpawnPoints && SpawnPoints->IsOccupied(SpawnPoint->GetActorLocation(), MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius(), MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()))
 		{
-			if (OtherPawn != MyPawn)
-			{
-				const float CombinedHeight = (MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
-				const float CombinedRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
-				const FVector OtherLocation = OtherPawn->GetActorLocation();
-
-				// check if player start overlaps this pawn
-				if (FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius)
-				{
-					return false;
-				}
-			}
+			return false;
 		}
 	}
 	else
@@ -566,6 +777,70 @@ void AShooterGameMode::RestartGame()
 		}
 	}
 
+	if (CVar_ShooterMatch_ResetInPlace > 0 && GetMatchState() == MatchState::WaitingPostMatch && GameSession->CanRestartGame())
+	{
+		ResetMatch();
+		return;
+	}
+
 	Super::RestartGame();
 }
 
+void AShooterGameMode::ResetMatch()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterMatchReset);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// restarts queued for previous match are dropped
+	PendingRespawns.Reset();
+	AssignedStarts.Reset();
+
+	// park alive pawns before level reset destroys them, dead ones go away with it
+	UShooterPawnPool* PawnPool = UShooterPawnPool::Get(this);
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		AController* Controller = It->Get();
+		AShooterCharacter* MyPawn = Controller ? Cast<AShooterCharacter>(Controller->GetPawn()) : NULL;
+		if (MyPawn && MyPawn->IsAlive() && PawnPool)
+		{
+			Controller->UnPossess();
+			PawnPool->ReleasePawn(MyPawn);
+		}
+	}
+
+	UShooterDroppedAmmoPool* DroppedAmmoPool = UShooterDroppedAmmoPool::Get(this);
+	if (DroppedAmmoPool)
+	{
+		DroppedAmmoPool->RecycleAllDrops();
+	}
+
+	// resets controllers, player and game state, level pickups and remaining pawns
+	// net connections and actor channels are kept, clients only get ClientReset
+	ResetLevel();
+
+	// back to warmup, HandleMatchHasStarted restarts everyone through respawn queue again
+	SetMatchState(MatchState::WaitingToStart);
+
+	MatchResetDuration = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogShooter, Log, TEXT("Match reset in place in %.2f ms"), MatchResetDuration * 1000.0);
+}
+
+bool AShooterGameMode::ShouldReset_Implementation(AActor* ActorToReset)
+{
+	// parked pawns would be destroyed and pool drops respawned
+	const AShooterCharacter* Character = Cast<AShooterCharacter>(ActorToReset);
+	if (Character && Character->IsPooled())
+	{
+		return false;
+	}
+
+	AShooterPickup* Pickup = Cast<AShooterPickup>(ActorToReset);
+	if (Pickup && !LevelPickups.Contains(Pickup))
+	{
+		return false;
+	}
+
+	return Super::ShouldReset_Implementation(ActorToReset);
+}
+
@@ -5,6 +5,7 @@
 #include "ShooterOnlineGameSettings.h"
 #include "OnlineSubsystemSessionSettings.h"
 #include "OnlineSubsystemUtils.h"
+#include "ShooterEngine.h"
 
 namespace
 {
@@ -61,6 +62,12 @@ void AShooterGameSession::OnStartOnlineGameComplete(FName InSessionName, bool bW
 /** Handle starting the match */
 void AShooterGameSession::HandleMatchHasStarted()
 {
+	// online session belongs to main match, extra matches in same process share it
+	if (UShooterEngine::IsExtraMatchWorld(GetWorld()))
+	{
+		return;
+	}
+
 	// start online game locally and wait for completion
 	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub)
@@ -81,6 +88,12 @@ void AShooterGameSession::HandleMatchHasStarted()
  */
 void AShooterGameSession::HandleMatchHasEnded()
 {
+	// ending it here would end session of main match while it's still running
+	if (UShooterEngine::IsExtraMatchWorld(GetWorld()))
+	{
+		return;
+	}
+
 	// end online game locally 
 	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub)
@@ -9,6 +9,8 @@ AShooterGameState::AShooterGameState(const FObjectInitializer& ObjectInitializer
 	NumTeams = 0;
 	RemainingTime = 0;
 	bTimerPaused = false;
+	RankingVersion = 1;
+	ProjectileStream.Owner = this;
 }
 
 void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
@@ -19,38 +21,133 @@ void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	DOREPLIFETIME( AShooterGameState, RemainingTime );
 	DOREPLIFETIME( AShooterGameState, bTimerPaused );
 	DOREPLIFETIME( AShooterGameState, TeamScores );
+	DOREPLIFETIME( AShooterGameState, ProjectileStream );
+}
+
+void AShooterGameState::Reset()
+{
+	Super::Reset();
+
+	// keep team count, teams are reused by next match
+	for (int32& TeamScore : TeamScores)
+	{
+		TeamScore = 0;
+	}
+
+	RemainingTime = 0;
+	ElapsedTime = 0;
+	bTimerPaused = false;
+}
+
+void AShooterGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+
+	UpdatePlayerRank(Cast<AShooterPlayerState>(PlayerState));
+}
+
+void AShooterGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	RemoveFromRanking(Cast<AShooterPlayerState>(PlayerState));
+
+	Super::RemovePlayerState(PlayerState);
 }
 
 void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
 {
 	OutRankedMap.Empty();
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+	// ranking is already sorted, just number it
+	int32 Rank = 0;
+	for (const FRankedPlayer& RankedPlayer : GetTeamRanking(TeamIndex))
+	{
+		OutRankedMap.Add(Rank++, RankedPlayer.PlayerState);
+	}
+}
+
+const TArray<AShooterGameState::FRankedPlayer>& AShooterGameState::GetTeamRanking(int32 TeamIndex) const
+{
+	static const TArray<FRankedPlayer> EmptyRanking;
+	return TeamRankings.IsValidIndex(TeamIndex) ? TeamRankings[TeamIndex] : EmptyRanking;
+}
+
+uint32 AShooterGameState::GetRankingVersion() const
+{
+	return RankingVersion;
+}
+
+void AShooterGameState::UpdatePlayerRank(AShooterPlayerState* PlayerState)
+{
+	if (PlayerState == NULL)
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		return;
+	}
+
+	// inactive players are kept out of PlayerArray, and so out of ranking
+	const int32 TeamIndex = PlayerState->GetTeamNum();
+	if (TeamIndex < 0 || !PlayerArray.Contains(PlayerState))
+	{
+		RemoveFromRanking(PlayerState);
+		return;
+	}
+
+	const int32 Score = FMath::TruncToInt(PlayerState->GetScore());
+	const int32* RankedTeam = RankedTeams.Find(PlayerState);
+	if (RankedTeam && *RankedTeam == TeamIndex)
+	{
+		TArray<FRankedPlayer>& Ranking = TeamRankings[TeamIndex];
+		const int32 RankIdx = Ranking.IndexOfByPredicate([PlayerState](const FRankedPlayer& RankedPlayer) { return RankedPlayer.PlayerState == PlayerState; });
+		check(RankIdx != INDEX_NONE);
+
+		// most score changes don't pass anyone
+		const bool bBelowPrev = (RankIdx == 0) || (Ranking[RankIdx - 1].Score >= Score);
+		const bool bAboveNext = (RankIdx == Ranking.Num() - 1) || (Ranking[RankIdx + 1].Score <= Score);
+		if (bBelowPrev && bAboveNext)
 		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->GetScore()), CurPlayerState);
+			Ranking[RankIdx].Score = Score;
+			return;
 		}
-	}
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+		Ranking.RemoveAt(RankIdx);
+	}
+	else
+	{
+		RemoveFromRanking(PlayerState);
+	}
 
-	//now, add them back to the ranked map
-	OutRankedMap.Empty();
+	if (TeamIndex >= TeamRankings.Num())
+	{
+		TeamRankings.SetNum(TeamIndex + 1);
+	}
 
-	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+	// after players with same score, ties keep order in which they were reached
+	TArray<FRankedPlayer>& Ranking = TeamRankings[TeamIndex];
+	int32 InsertIdx = 0;
+	while (InsertIdx < Ranking.Num() && Ranking[InsertIdx].Score >= Score)
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		InsertIdx++;
 	}
-	
+
+	FRankedPlayer RankedPlayer;
+	RankedPlayer.PlayerState = PlayerState;
+	RankedPlayer.Score = Score;
+	Ranking.Insert(RankedPlayer, InsertIdx);
+
+	RankedTeams.Add(PlayerState, TeamIndex);
+	RankingVersion++;
 }
 
+void AShooterGameState::RemoveFromRanking(AShooterPlayerState* PlayerState)
+{
+	int32 TeamIndex = INDEX_NONE;
+	if (PlayerState == NULL || !RankedTeams.RemoveAndCopyValue(PlayerState, TeamIndex))
+	{
+		return;
+	}
+
+	TeamRankings[TeamIndex].RemoveAll([PlayerState](const FRankedPlayer& RankedPlayer) { return RankedPlayer.PlayerState == PlayerState; });
+	RankingVersion++;
+}
 
 void AShooterGameState::RequestFinishAndExitToMainMenu()
 {
@@ -26,6 +26,8 @@ void AShooterPlayerState::Reset()
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
+
+	UpdateRank();
 }
 
 void AShooterPlayerState::RegisterPlayerWithSession(bool bWasFromInvite)
@@ -56,11 +58,20 @@ void AShooterPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	UpdateRank();
 }
 
 void AShooterPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	UpdateRank();
+}
+
+void AShooterPlayerState::OnRep_Score()
+{
+	Super::OnRep_Score();
+
+	UpdateRank();
 }
 
 void AShooterPlayerState::AddBulletsFired(int32 NumBullets)
@@ -107,6 +118,15 @@ void AShooterPlayerState::UpdateTeamColors()
 	}
 }
 
+void AShooterPlayerState::UpdateRank()
+{
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->UpdatePlayerRank(this);
+	}
+}
+
 int32 AShooterPlayerState::GetTeamNum() const
 {
 	return TeamNumber;
@@ -168,6 +188,7 @@ void AShooterPlayerState::ScorePoints(int32 Points)
 	}
 
 	SetScore(GetScore() + Points);
+	UpdateRank();
 }
 
 void AShooterPlayerState::InformAboutKill_Implementation(class AShooterPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* KilledPlayerState)
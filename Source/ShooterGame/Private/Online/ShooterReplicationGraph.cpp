@@ -50,6 +50,7 @@
 *		the graph leaner since no extra work has to be done for the weapon actors.
 *		
 *		See UShooterReplicationGraph::OnCharacterWeaponChange: this is how actors are added/removed from the dependent actor list. 
+*		Weapons parked in UShooterWeaponPool have no pawn to replicate with, so they go to the GridNode as dormancy actors until handed out again (see OnWeaponPooled).
 *	
 *	How To Use
 *	
@@ -96,6 +97,7 @@
 #include "Player/ShooterCharacter.h"
 #include "Online/ShooterPlayerState.h"
 #include "Weapons/ShooterWeapon.h"
+#include "Weapons/ShooterWeaponPool.h"
 #include "Pickups/ShooterPickup.h"
 
 DEFINE_LOG_CATEGORY( LogShooterReplicationGraph );
@@ -156,6 +158,7 @@ void UShooterReplicationGraph::ResetGameWorldState()
 	Super::ResetGameWorldState();
 
 	AlwaysRelevantStreamingLevelActors.Empty();
+	PooledWeapons.Empty();
 
 	for (UNetReplicationGraphConnection* ConnManager : Connections)
 	{
@@ -350,6 +353,8 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	
 	AShooterCharacter::NotifyEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterEquipWeapon);
 	AShooterCharacter::NotifyUnEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterUnEquipWeapon);
+	UShooterWeaponPool::NotifyWeaponPooled.AddUObject(this, &UShooterReplicationGraph::OnWeaponPooled);
+	UShooterWeaponPool::NotifyWeaponUnpooled.AddUObject(this, &UShooterReplicationGraph::OnWeaponUnpooled);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &UShooterReplicationGraph::OnGameplayDebuggerOwnerChange);
@@ -464,6 +469,11 @@ void UShooterReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicat
 	{
 		case EClassRepNodeMapping::NotRouted:
 		{
+			// pooled weapons are routed by hand, see OnWeaponPooled
+			if (PooledWeapons.Remove(ActorInfo.Actor) > 0)
+			{
+				GridNode->RemoveActor_Dormancy(ActorInfo);
+			}
 			break;
 		}
 		
@@ -531,6 +541,37 @@ void UShooterReplicationGraph::OnCharacterUnEquipWeapon(AShooterCharacter* Chara
 	}
 }
 
+void UShooterReplicationGraph::OnWeaponPooled(AShooterWeapon* Weapon)
+{
+	if (Weapon)
+	{
+		CHECK_WORLDS(Weapon);
+
+		// no longer replicated through owning pawn: keep it in grid until detach and dormancy reach clients,
+		// otherwise channel would never close as dormant and clients would keep stale attached weapon
+		bool bAlreadyInSet = false;
+		PooledWeapons.Add(Weapon, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			GridNode->AddActor_Dormancy(FNewReplicatedActorInfo(Weapon), GlobalActorReplicationInfoMap.Get(Weapon));
+		}
+	}
+}
+
+void UShooterReplicationGraph::OnWeaponUnpooled(AShooterWeapon* Weapon)
+{
+	if (Weapon)
+	{
+		CHECK_WORLDS(Weapon);
+
+		// back to DependantActor replication once equipped
+		if (PooledWeapons.Remove(Weapon) > 0)
+		{
+			GridNode->RemoveActor_Dormancy(FNewReplicatedActorInfo(Weapon));
+		}
+	}
+}
+
 #if WITH_GAMEPLAY_DEBUGGER
 void UShooterReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
 {
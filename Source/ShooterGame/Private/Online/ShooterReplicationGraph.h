@@ -64,6 +64,8 @@ public:
 
 	void OnCharacterEquipWeapon(AShooterCharacter* Character, AShooterWeapon* NewWeapon);
 	void OnCharacterUnEquipWeapon(AShooterCharacter* Character, AShooterWeapon* OldWeapon);
+	void OnWeaponPooled(AShooterWeapon* Weapon);
+	void OnWeaponUnpooled(AShooterWeapon* Weapon);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	void OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner);
@@ -78,6 +80,9 @@ private:
 	bool IsSpatialized(EClassRepNodeMapping Mapping) const { return Mapping >= EClassRepNodeMapping::Spatialize_Static; }
 
 	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
+
+	/** pooled weapons, routed to GridNode as dormancy actors until handed out again */
+	TSet<AActor*> PooledWeapons;
 };
 
 UCLASS()
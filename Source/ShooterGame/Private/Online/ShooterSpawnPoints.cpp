@@ -0,0 +1,256 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterSpawnPoints.h"
+#include "Online/ShooterPlayerState.h"
+#include "Player/ShooterCharacterGrid.h"
+#include "GameFramework/PlayerStart.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Danger Update"), STAT_ShooterSpawnDangerUpdate, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Danger Sources Moved"), STAT_ShooterSpawnDangerSourcesMoved, STATGROUP_ShooterGame);
+
+float CVar_ShooterSpawn_DangerRadius = 3000.f;
+static FAutoConsoleVariableRef CVarShooterSpawnDangerRadius(TEXT("ShooterSpawn.DangerRadius"), CVar_ShooterSpawn_DangerRadius, TEXT("Characters make starts within this distance dangerous, applied when starts are cached"), ECVF_Default );
+
+float CVar_ShooterSpawn_DangerUpdateInterval = 0.25f;
+static FAutoConsoleVariableRef CVarShooterSpawnDangerUpdateInterval(TEXT("ShooterSpawn.DangerUpdateInterval"), CVar_ShooterSpawn_DangerUpdateInterval, TEXT("Min time between spawn danger updates"), ECVF_Default );
+
+float CVar_ShooterSpawn_DangerMoveThreshold = 200.f;
+static FAutoConsoleVariableRef CVarShooterSpawnDangerMoveThreshold(TEXT("ShooterSpawn.DangerMoveThreshold"), CVar_ShooterSpawn_DangerMoveThreshold, TEXT("Distance character has to move before its spawn danger is updated"), ECVF_Default );
+
+UShooterSpawnPoints::UShooterSpawnPoints()
+{
+	CellSize = 1000.0f;
+	LastDangerUpdateTime = -MAX_FLT;
+	DangerUpdateId = 0;
+	bStartsCached = false;
+}
+
+UShooterSpawnPoints* UShooterSpawnPoints::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterSpawnPoints>() : NULL;
+}
+
+void UShooterSpawnPoints::Deinitialize()
+{
+	Starts.Empty();
+	StartIndices.Empty();
+	TotalDanger.Empty();
+	TeamDanger.Empty();
+	StartCells.Empty();
+	DangerSources.Empty();
+	bStartsCached = false;
+
+	Super::Deinitialize();
+}
+
+void UShooterSpawnPoints::CacheStarts()
+{
+	Starts.Reset();
+	StartIndices.Reset();
+	StartCells.Reset();
+	DangerSources.Reset();
+	TeamDanger.Reset();
+	LastDangerUpdateTime = -MAX_FLT;
+	bStartsCached = true;
+
+	CellSize = FMath::Max(CVar_ShooterSpawn_DangerRadius, 100.0f);
+
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		const int32 StartIdx = Starts.Add(*It);
+		StartIndices.Add(*It, StartIdx);
+		StartCells.FindOrAdd(GetCell(It->GetActorLocation())).Add(StartIdx);
+	}
+
+	TotalDanger.Reset();
+	TotalDanger.AddZeroed(Starts.Num());
+}
+
+const TArray<APlayerStart*>& UShooterSpawnPoints::GetStarts()
+{
+	if (!bStartsCached)
+	{
+		CacheStarts();
+	}
+
+	return Starts;
+}
+
+int32 UShooterSpawnPoints::GetStartIndex(const APlayerStart* Start) const
+{
+	const int32* StartIdx = StartIndices.Find(Start);
+	return StartIdx ? *StartIdx : INDEX_NONE;
+}
+
+bool UShooterSpawnPoints::IsOccupied(const FVector& SpawnLocation, float Radius, float HalfHeight) const
+{
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (CharacterGrid == NULL)
+	{
+		return false;
+	}
+
+	// other capsules are expected to be similar, exact test follows
+	TArray<AShooterCharacter*> NearbyCharacters;
+	CharacterGrid->QueryRadius(SpawnLocation, (Radius + HalfHeight) * 4.0f, NearbyCharacters);
+
+	for (AShooterCharacter* OtherPawn : NearbyCharacters)
+	{
+		const float CombinedHeight = (HalfHeight + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
+		const float CombinedRadius = Radius + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		const FVector OtherLocation = OtherPawn->GetActorLocation();
+
+		// check if player start overlaps this pawn
+		if (FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+float UShooterSpawnPoints::GetDanger(int32 StartIdx, int32 FriendlyTeam) const
+{
+	if (!TotalDanger.IsValidIndex(StartIdx))
+	{
+		return 0.0f;
+	}
+
+	float Danger = TotalDanger[StartIdx];
+	if (TeamDanger.IsValidIndex(FriendlyTeam))
+	{
+		Danger -= TeamDanger[FriendlyTeam][StartIdx];
+	}
+
+	return FMath::Max(Danger, 0.0f);
+}
+
+void UShooterSpawnPoints::UpdateDanger()
+{
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	if (GameTime - LastDangerUpdateTime < CVar_ShooterSpawn_DangerUpdateInterval)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterSpawnDangerUpdate);
+
+	GetStarts();
+	LastDangerUpdateTime = GameTime;
+	DangerUpdateId++;
+
+	const float MoveThresholdSq = FMath::Square(CVar_ShooterSpawn_DangerMoveThreshold);
+	for (AShooterCharacter* Character : TActorRange<AShooterCharacter>(GetWorld()))
+	{
+		if (!Character->IsAlive() || Character->IsPooled())
+		{
+			continue;
+		}
+
+		const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Character->GetPlayerState());
+		const int32 Team = PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE;
+		const FVector Location = Character->GetActorLocation();
+
+		FDangerSource* Source = DangerSources.Find(Character);
+		if (Source == NULL)
+		{
+			Source = &DangerSources.Add(Character);
+		}
+		else if (Source->Team == Team && FVector::DistSquared(Source->Location, Location) < MoveThresholdSq)
+		{
+			Source->UpdateId = DangerUpdateId;
+			continue;
+		}
+		else
+		{
+			ApplyDanger(*Source, false);
+		}
+
+		INC_DWORD_STAT(STAT_ShooterSpawnDangerSourcesMoved);
+		Source->Location = Location;
+		Source->Team = Team;
+		Source->UpdateId = DangerUpdateId;
+		ApplyDanger(*Source, true);
+	}
+
+	// dead, pooled and destroyed characters are no longer dangerous
+	for (auto It = DangerSources.CreateIterator(); It; ++It)
+	{
+		if (It.Value().UpdateId != DangerUpdateId)
+		{
+			ApplyDanger(It.Value(), false);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UShooterSpawnPoints::ApplyDanger(FDangerSource& Source, bool bAdd)
+{
+	if (!bAdd)
+	{
+		for (const TPair<int32, float>& Contribution : Source.Contributions)
+		{
+			TotalDanger[Contribution.Key] -= Contribution.Value;
+			if (TeamDanger.IsValidIndex(Source.Team))
+			{
+				TeamDanger[Source.Team][Contribution.Key] -= Contribution.Value;
+			}
+		}
+
+		Source.Contributions.Reset();
+		return;
+	}
+
+	if (Source.Team >= 0 && Source.Team >= TeamDanger.Num())
+	{
+		const int32 FirstNewTeam = TeamDanger.Num();
+		TeamDanger.SetNum(Source.Team + 1);
+		for (int32 TeamIdx = FirstNewTeam; TeamIdx < TeamDanger.Num(); TeamIdx++)
+		{
+			TeamDanger[TeamIdx].AddZeroed(Starts.Num());
+		}
+	}
+
+	const float DangerRadius = CellSize;
+	const FIntPoint MinCell = GetCell(Source.Location - FVector(DangerRadius));
+	const FIntPoint MaxCell = GetCell(Source.Location + FVector(DangerRadius));
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			const TArray<int32>* Cell = StartCells.Find(FIntPoint(CellX, CellY));
+			if (Cell == NULL)
+			{
+				continue;
+			}
+
+			for (int32 StartIdx : *Cell)
+			{
+				if (Starts[StartIdx] == NULL)
+				{
+					continue;
+				}
+
+				const float Dist = FVector::Dist(Starts[StartIdx]->GetActorLocation(), Source.Location);
+				if (Dist < DangerRadius)
+				{
+					const float Danger = 1.0f - Dist / DangerRadius;
+					Source.Contributions.Add(TPair<int32, float>(StartIdx, Danger));
+					TotalDanger[StartIdx] += Danger;
+					if (TeamDanger.IsValidIndex(Source.Team))
+					{
+						TeamDanger[Source.Team][StartIdx] += Danger;
+					}
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UShooterSpawnPoints::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
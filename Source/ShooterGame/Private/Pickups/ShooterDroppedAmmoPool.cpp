@@ -0,0 +1,176 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterDroppedAmmoPool.h"
+#include "Pickups/ShooterPickup_Ammo.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dropped Ammo Pickups"), STAT_ShooterDroppedAmmoPickups, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped Ammo Merged"), STAT_ShooterDroppedAmmoMerged, STATGROUP_ShooterGame);
+
+int32 CVar_ShooterDroppedAmmo_MaxPickups = 16;
+static FAutoConsoleVariableRef CVarShooterDroppedAmmoMaxPickups(TEXT("ShooterDroppedAmmo.MaxPickups"), CVar_ShooterDroppedAmmo_MaxPickups, TEXT("Max number of dropped ammo pickups in world, oldest one is reused above it"), ECVF_Default );
+
+float CVar_ShooterDroppedAmmo_MergeRadius = 300.f;
+static FAutoConsoleVariableRef CVarShooterDroppedAmmoMergeRadius(TEXT("ShooterDroppedAmmo.MergeRadius"), CVar_ShooterDroppedAmmo_MergeRadius, TEXT("Ammo dropped within this distance of active pickup is added to it"), ECVF_Default );
+
+float CVar_ShooterDroppedAmmo_LifeTime = 30.f;
+static FAutoConsoleVariableRef CVarShooterDroppedAmmoLifeTime(TEXT("ShooterDroppedAmmo.LifeTime"), CVar_ShooterDroppedAmmo_LifeTime, TEXT("Time after which dropped ammo is recycled if nobody picked it up"), ECVF_Default );
+
+UShooterDroppedAmmoPool* UShooterDroppedAmmoPool::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterDroppedAmmoPool>() : NULL;
+}
+
+void UShooterDroppedAmmoPool::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_RecycleDrops);
+	}
+
+	DEC_DWORD_STAT_BY(STAT_ShooterDroppedAmmoPickups, Drops.Num());
+	Drops.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterDroppedAmmoPool::DropAmmo(TSubclassOf<AShooterPickup_Ammo> PickupClass, const FVector& Location, const FRotator& Rotation, int32 Ammo, int32 AmmoPerClip)
+{
+	if (PickupClass == NULL || Ammo <= 0 || AmmoPerClip <= 0)
+	{
+		return;
+	}
+
+	// free pickups taken since last recycle
+	RecycleDrops();
+
+	UWorld* World = GetWorld();
+	const float ExpireTime = World->GetTimeSeconds() + CVar_ShooterDroppedAmmo_LifeTime;
+	const float MergeRadiusSq = FMath::Square(CVar_ShooterDroppedAmmo_MergeRadius);
+
+	for (FDroppedAmmo& Drop : Drops)
+	{
+		AShooterPickup_Ammo* Pickup = Drop.Pickup.Get();
+		if (Drop.bInUse && Pickup->GetClass() == PickupClass && FVector::DistSquared(Pickup->GetActorLocation(), Location) <= MergeRadiusSq)
+		{
+			Drop.Ammo += Ammo;
+			Drop.ExpireTime = ExpireTime;
+			Pickup->SetAmmoClips(Drop.Ammo / AmmoPerClip);
+			Pickup->SetAdditionalBullets(Drop.Ammo % AmmoPerClip);
+
+			INC_DWORD_STAT(STAT_ShooterDroppedAmmoMerged);
+			return;
+		}
+	}
+
+	const int32 DropIdx = FindReusableDrop(PickupClass);
+	if (DropIdx != INDEX_NONE)
+	{
+		FDroppedAmmo& Drop = Drops[DropIdx];
+		Drop.Ammo = Ammo;
+		Drop.ExpireTime = ExpireTime;
+		Drop.bInUse = true;
+
+		AShooterPickup_Ammo* Pickup = Drop.Pickup.Get();
+		Pickup->DeactivatePickup();
+		Pickup->SetAmmoClips(Ammo / AmmoPerClip);
+		Pickup->SetAdditionalBullets(Ammo % AmmoPerClip);
+		Pickup->ActivatePickup(Location, Rotation);
+	}
+	else
+	{
+		// set ammo before BeginPlay, it can be picked up right away
+		const FTransform SpawnTransform(Rotation, Location);
+		AShooterPickup_Ammo* Pickup = World->SpawnActorDeferred<AShooterPickup_Ammo>(PickupClass, SpawnTransform, NULL, NULL, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Pickup == NULL)
+		{
+			return;
+		}
+
+		Pickup->SetAmmoClips(Ammo / AmmoPerClip);
+		Pickup->SetAdditionalBullets(Ammo % AmmoPerClip);
+		Pickup->FinishSpawning(SpawnTransform);
+
+		FDroppedAmmo Drop;
+		Drop.Pickup = Pickup;
+		Drop.Ammo = Ammo;
+		Drop.ExpireTime = ExpireTime;
+		Drop.bInUse = true;
+		Drops.Add(Drop);
+		INC_DWORD_STAT(STAT_ShooterDroppedAmmoPickups);
+	}
+
+	if (!World->GetTimerManager().IsTimerActive(TimerHandle_RecycleDrops))
+	{
+		World->GetTimerManager().SetTimer(TimerHandle_RecycleDrops, this, &UShooterDroppedAmmoPool::RecycleDrops, 1.0f, true);
+	}
+}
+
+void UShooterDroppedAmmoPool::RecycleDrops()
+{
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	for (int32 DropIdx = Drops.Num() - 1; DropIdx >= 0; DropIdx--)
+	{
+		FDroppedAmmo& Drop = Drops[DropIdx];
+		AShooterPickup_Ammo* Pickup = Drop.Pickup.Get();
+		if (Pickup == NULL || Pickup->IsPendingKill())
+		{
+			Drops.RemoveAtSwap(DropIdx);
+			DEC_DWORD_STAT(STAT_ShooterDroppedAmmoPickups);
+			continue;
+		}
+
+		// dropped ammo doesn't respawn once taken
+		if (Drop.bInUse && (!Pickup->IsActive() || GameTime >= Drop.ExpireTime))
+		{
+			Pickup->DeactivatePickup();
+			Drop.bInUse = false;
+			Drop.Ammo = 0;
+		}
+	}
+}
+
+void UShooterDroppedAmmoPool::RecycleAllDrops()
+{
+	for (FDroppedAmmo& Drop : Drops)
+	{
+		AShooterPickup_Ammo* Pickup = Drop.Pickup.Get();
+		if (Drop.bInUse && Pickup)
+		{
+			Pickup->DeactivatePickup();
+		}
+
+		Drop.bInUse = false;
+		Drop.Ammo = 0;
+	}
+
+	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_RecycleDrops);
+}
+
+int32 UShooterDroppedAmmoPool::FindReusableDrop(TSubclassOf<AShooterPickup_Ammo> PickupClass) const
+{
+	int32 OldestIdx = INDEX_NONE;
+	for (int32 DropIdx = 0; DropIdx < Drops.Num(); DropIdx++)
+	{
+		const FDroppedAmmo& Drop = Drops[DropIdx];
+		if (Drop.Pickup->GetClass() != PickupClass)
+		{
+			continue;
+		}
+
+		if (!Drop.bInUse)
+		{
+			return DropIdx;
+		}
+
+		if (OldestIdx == INDEX_NONE || Drop.ExpireTime < Drops[OldestIdx].ExpireTime)
+		{
+			OldestIdx = DropIdx;
+		}
+	}
+
+	// below cap new pickup is spawned, above it oldest active drop is moved
+	return (Drops.Num() < CVar_ShooterDroppedAmmo_MaxPickups) ? INDEX_NONE : OldestIdx;
+}
@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "Pickups/ShooterPickup.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Effects/ShooterEffectBudget.h"
+#include "Pickups/ShooterPickupIndex.h"
 
 AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -34,13 +36,34 @@ void AShooterPickup::BeginPlay()
 	RespawnPickup();
 
 	// register on pickup list (server only), don't care about unregistering (in FinishDestroy) - no streaming
+	// pickups spawned at runtime (dropped ammo) are owned by their pool
 	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
-	if (GameMode)
+	if (GameMode && IsNetStartupActor())
 	{
 		GameMode->LevelPickups.Add(this);
 	}
 }
 
+void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UShooterPickupIndex* PickupIndex = UShooterPickupIndex::Get(this);
+	if (PickupIndex)
+	{
+		PickupIndex->RemovePickup(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterPickup::UpdatePickupIndex()
+{
+	UShooterPickupIndex* PickupIndex = (GetLocalRole() == ROLE_Authority) ? UShooterPickupIndex::Get(this) : NULL;
+	if (PickupIndex)
+	{
+		PickupIndex->UpdatePickup(this);
+	}
+}
+
 void AShooterPickup::NotifyActorBeginOverlap(class AActor* Other)
 {
 	Super::NotifyActorBeginOverlap(Other);
@@ -52,6 +75,57 @@ bool AShooterPickup::CanBePickedUp(class AShooterCharacter* TestPawn) const
 	return TestPawn && TestPawn->IsAlive();
 }
 
+bool AShooterPickup::IsActive() const
+{
+	return bIsActive;
+}
+
+UClass* AShooterPickup::GetPickupType() const
+{
+	return GetClass();
+}
+
+void AShooterPickup::ActivatePickup(const FVector& Location, const FRotator& Rotation)
+{
+	// wake up channel first, so new location is sent with movement replication
+	SetNetDormancy(DORM_Awake);
+	FlushNetDormancy();
+	SetReplicatingMovement(true);
+	SetActorLocationAndRotation(Location, Rotation);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	RespawnPickup();
+}
+
+void AShooterPickup::DeactivatePickup()
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_RespawnPickup);
+
+	// not picked up by anyone, skip pickup effects and events
+	bIsActive = false;
+	PickedUpBy = NULL;
+	PickupPSC->DeactivateSystem();
+	UpdatePickupIndex();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	// hidden state still replicates, then channel closes as dormant
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AShooterPickup::Reset()
+{
+	Super::Reset();
+
+	GetWorldTimerManager().ClearTimer(TimerHandle_RespawnPickup);
+	if (!bIsActive)
+	{
+		RespawnPickup();
+	}
+}
+
 void AShooterPickup::GivePickupTo(class AShooterCharacter* Pawn)
 {
 }
@@ -111,6 +185,7 @@ void AShooterPickup::OnPickedUp()
 		UGameplayStatics::SpawnSoundAttached(PickupSound, PickedUpBy->GetRootComponent());
 	}
 
+	UpdatePickupIndex();
 	OnPickedUpEvent();
 }
 
@@ -127,11 +202,13 @@ void AShooterPickup::OnRespawned()
 	}
 
 	const bool bJustSpawned = CreationTime <= (GetWorld()->GetTimeSeconds() + 5.0f);
-	if (RespawnSound && !bJustSpawned)
+	UShooterEffectBudget* EffectBudget = UShooterEffectBudget::Get(this);
+	if (RespawnSound && !bJustSpawned && EffectBudget)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, RespawnSound, GetActorLocation());
+		EffectBudget->PlaySoundAtLocation(RespawnSound, GetActorLocation());
 	}
 
+	UpdatePickupIndex();
 	OnRespawnEvent();
 }
 
@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterPickupIndex.h"
+#include "Pickups/ShooterPickup.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Index Query"), STAT_ShooterPickupIndexQuery, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Indexed Pickups"), STAT_ShooterIndexedPickups, STATGROUP_ShooterGame);
+
+float CVar_ShooterPickupIndex_CellSize = 2000.f;
+static FAutoConsoleVariableRef CVarShooterPickupIndexCellSize(TEXT("ShooterPickupIndex.CellSize"), CVar_ShooterPickupIndex_CellSize, TEXT("Size of pickup index cell, applied on map load"), ECVF_Default );
+
+UShooterPickupIndex* UShooterPickupIndex::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterPickupIndex>() : NULL;
+}
+
+void UShooterPickupIndex::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = FMath::Max(CVar_ShooterPickupIndex_CellSize, 100.0f);
+}
+
+void UShooterPickupIndex::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterIndexedPickups, IndexedPickups.Num());
+	IndexedPickups.Empty();
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterPickupIndex::UpdatePickup(AShooterPickup* Pickup)
+{
+	if (Pickup == NULL)
+	{
+		return;
+	}
+
+	const FIndexedPickup* Indexed = IndexedPickups.Find(Pickup);
+	const bool bWantsIndex = Pickup->IsActive() && !Pickup->IsPendingKill();
+	if (Indexed && bWantsIndex && Indexed->Cell == GetCell(Pickup->GetActorLocation()) && Indexed->Type == Pickup->GetPickupType())
+	{
+		return;
+	}
+
+	RemovePickup(Pickup);
+
+	if (bWantsIndex)
+	{
+		FIndexedPickup NewIndexed;
+		NewIndexed.Type = Pickup->GetPickupType();
+		NewIndexed.Cell = GetCell(Pickup->GetActorLocation());
+		IndexedPickups.Add(Pickup, NewIndexed);
+		INC_DWORD_STAT(STAT_ShooterIndexedPickups);
+
+		FPickupBucket& Bucket = Buckets.FindOrAdd(NewIndexed.Type);
+		Bucket.Cells.FindOrAdd(NewIndexed.Cell).Add(Pickup);
+		Bucket.MinCell = FIntPoint(FMath::Min(Bucket.MinCell.X, NewIndexed.Cell.X), FMath::Min(Bucket.MinCell.Y, NewIndexed.Cell.Y));
+		Bucket.MaxCell = FIntPoint(FMath::Max(Bucket.MaxCell.X, NewIndexed.Cell.X), FMath::Max(Bucket.MaxCell.Y, NewIndexed.Cell.Y));
+		Bucket.NumPickups++;
+	}
+}
+
+void UShooterPickupIndex::RemovePickup(AShooterPickup* Pickup)
+{
+	FIndexedPickup Indexed;
+	if (!IndexedPickups.RemoveAndCopyValue(Pickup, Indexed))
+	{
+		return;
+	}
+
+	DEC_DWORD_STAT(STAT_ShooterIndexedPickups);
+
+	// bucket bounds only grow, pickups don't move much
+	FPickupBucket& Bucket = Buckets.FindChecked(Indexed.Type);
+	TArray<AShooterPickup*>& Cell = Bucket.Cells.FindChecked(Indexed.Cell);
+	Cell.RemoveSingleSwap(Pickup);
+	Bucket.NumPickups--;
+}
+
+void UShooterPickupIndex::FindNearest(UClass* Type, const FVector& Location, int32 Count, float MaxRadius, TFunctionRef<bool(AShooterPickup*)> Predicate, TArray<AShooterPickup*>& OutPickups) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPickupIndexQuery);
+
+	OutPickups.Reset();
+	if (Type == NULL || Count <= 0)
+	{
+		return;
+	}
+
+	const FIntPoint CenterCell = GetCell(Location);
+
+	// search only rings that can contain anything
+	TArray<const FPickupBucket*, TInlineAllocator<4>> MatchingBuckets;
+	int32 MaxRing = 0;
+	for (const TPair<UClass*, FPickupBucket>& Bucket : Buckets)
+	{
+		if (Bucket.Value.NumPickups > 0 && Bucket.Key->IsChildOf(Type))
+		{
+			MatchingBuckets.Add(&Bucket.Value);
+			MaxRing = FMath::Max(MaxRing, FMath::Abs(Bucket.Value.MinCell.X - CenterCell.X));
+			MaxRing = FMath::Max(MaxRing, FMath::Abs(Bucket.Value.MinCell.Y - CenterCell.Y));
+			MaxRing = FMath::Max(MaxRing, FMath::Abs(Bucket.Value.MaxCell.X - CenterCell.X));
+			MaxRing = FMath::Max(MaxRing, FMath::Abs(Bucket.Value.MaxCell.Y - CenterCell.Y));
+		}
+	}
+
+	if (MatchingBuckets.Num() == 0)
+	{
+		return;
+	}
+
+	if (MaxRadius / CellSize < MaxRing)
+	{
+		MaxRing = FMath::CeilToInt(MaxRadius / CellSize) + 1;
+	}
+
+	const float MaxRadiusSq = FMath::Square(MaxRadius);
+	TArray<TPair<float, AShooterPickup*>, TInlineAllocator<16>> Found;
+
+	auto GatherCell = [&](int32 CellX, int32 CellY)
+	{
+		for (const FPickupBucket* Bucket : MatchingBuckets)
+		{
+			const TArray<AShooterPickup*>* Cell = Bucket->Cells.Find(FIntPoint(CellX, CellY));
+			if (Cell)
+			{
+				for (AShooterPickup* Pickup : *Cell)
+				{
+					const float DistSq = FVector::DistSquared(Pickup->GetActorLocation(), Location);
+					if (DistSq <= MaxRadiusSq && Predicate(Pickup))
+					{
+						Found.Add(TPair<float, AShooterPickup*>(DistSq, Pickup));
+					}
+				}
+			}
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		if (Ring == 0)
+		{
+			GatherCell(CenterCell.X, CenterCell.Y);
+		}
+		else
+		{
+			for (int32 Offset = -Ring; Offset <= Ring; Offset++)
+			{
+				GatherCell(CenterCell.X + Offset, CenterCell.Y - Ring);
+				GatherCell(CenterCell.X + Offset, CenterCell.Y + Ring);
+			}
+			for (int32 Offset = -Ring + 1; Offset <= Ring - 1; Offset++)
+			{
+				GatherCell(CenterCell.X - Ring, CenterCell.Y + Offset);
+				GatherCell(CenterCell.X + Ring, CenterCell.Y + Offset);
+			}
+		}
+
+		// anything in further rings is at least Ring cells away
+		if (Found.Num() >= Count)
+		{
+			Found.Sort([](const TPair<float, AShooterPickup*>& A, const TPair<float, AShooterPickup*>& B) { return A.Key < B.Key; });
+			if (Found[Count - 1].Key <= FMath::Square(Ring * CellSize))
+			{
+				break;
+			}
+		}
+	}
+
+	Found.Sort([](const TPair<float, AShooterPickup*>& A, const TPair<float, AShooterPickup*>& B) { return A.Key < B.Key; });
+	for (int32 FoundIdx = 0; FoundIdx < FMath::Min(Count, Found.Num()); FoundIdx++)
+	{
+		OutPickups.Add(Found[FoundIdx].Value);
+	}
+}
+
+void UShooterPickupIndex::QueryRadius(UClass* Type, const FVector& Center, float Radius, TArray<AShooterPickup*>& OutPickups) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPickupIndexQuery);
+
+	if (Type == NULL)
+	{
+		return;
+	}
+
+	const float RadiusSq = FMath::Square(Radius);
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+
+	for (const TPair<UClass*, FPickupBucket>& Bucket : Buckets)
+	{
+		if (Bucket.Value.NumPickups == 0 || !Bucket.Key->IsChildOf(Type))
+		{
+			continue;
+		}
+
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+			{
+				const TArray<AShooterPickup*>* Cell = Bucket.Value.Cells.Find(FIntPoint(CellX, CellY));
+				if (Cell == NULL)
+				{
+					continue;
+				}
+
+				for (AShooterPickup* Pickup : *Cell)
+				{
+					if (FVector::DistSquared(Pickup->GetActorLocation(), Center) <= RadiusSq)
+					{
+						OutPickups.Add(Pickup);
+					}
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UShooterPickupIndex::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
@@ -16,6 +16,11 @@ bool AShooterPickup_Ammo::IsForWeapon(UClass* WeaponClass)
 	return WeaponType->IsChildOf(WeaponClass);
 }
 
+UClass* AShooterPickup_Ammo::GetPickupType() const
+{
+	return WeaponType ? WeaponType.Get() : GetClass();
+}
+
 void AShooterPickup_Ammo::SetAmmoClips(int32 NClips)
 {
 	AmmoClips = NClips;
@@ -11,6 +11,11 @@
 #include "AudioThread.h"
 #include "ShooterPickup_Ammo.h"
 #include "ShooterWeapon_Projectile.h"
+#include "Effects/ShooterEffectBudget.h"
+#include "Effects/ShooterCorpseManager.h"
+#include "Player/ShooterCharacterGrid.h"
+#include "Weapons/ShooterWeaponPool.h"
+#include "Pickups/ShooterDroppedAmmoPool.h"
 
 static int32 NetVisualizeRelevancyTestPoints = 0;
 FAutoConsoleVariableRef CVarNetVisualizeRelevancyTestPoints(
@@ -69,10 +74,13 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	RunningSpeedModifier = 1.5f;
 	bWantsToRun = false;
 	bWantsToFire = false;
+	bIsPooled = false;
 	LowHealthPercentage = 0.5f;
 
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
+
+	Inventory.Owner = this;
 }
 
 void AShooterCharacter::PostInitializeComponents()
@@ -83,8 +91,17 @@ void AShooterCharacter::PostInitializeComponents()
 	{
 		Health = GetMaxHealth();
 
-		// Needs to happen after character is added to repgraph
-		GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::SpawnDefaultInventory);
+		// Needs to happen after character is added to repgraph, pooled pawn gets it when taken out
+		if (!bIsPooled)
+		{
+			GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::SpawnDefaultInventory);
+		}
+	}
+
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (CharacterGrid && !bIsPooled)
+	{
+		CharacterGrid->RegisterCharacter(this);
 	}
 
 	// set initial mesh visibility (3rd person view)
@@ -97,24 +114,129 @@ void AShooterCharacter::PostInitializeComponents()
 	}
 
 	// play respawn effects
-	if (GetNetMode() != NM_DedicatedServer)
+	UShooterEffectBudget* EffectBudget = UShooterEffectBudget::Get(this);
+	if (GetNetMode() != NM_DedicatedServer && EffectBudget && !bIsPooled)
+	{
+		if (RespawnFX)
+		{
+			EffectBudget->SpawnEmitterAtLocation(RespawnFX, GetActorLocation(), GetActorRotation(), GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+		}
+
+		if (RespawnSound)
+		{
+			EffectBudget->PlaySoundAtLocation(RespawnSound, GetActorLocation());
+		}
+	}
+}
+
+void AShooterCharacter::SetPooled(bool bNewPooled)
+{
+	bIsPooled = bNewPooled;
+
+	SetActorHiddenInGame(bNewPooled);
+	SetActorEnableCollision(!bNewPooled);
+	SetActorTickEnabled(!bNewPooled);
+	GetCharacterMovement()->SetComponentTickEnabled(!bNewPooled);
+
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (CharacterGrid)
+	{
+		if (bNewPooled)
+		{
+			CharacterGrid->UnregisterCharacter(this);
+		}
+		else
+		{
+			CharacterGrid->RegisterCharacter(this);
+		}
+	}
+
+	if (bNewPooled)
+	{
+		DestroyInventory();
+		StopAllAnimMontages();
+
+		// pawn that was already replicated stays on clients, hidden until reused
+		if (GetIsReplicated() && HasActorBegunPlay())
+		{
+			SetNetDormancy(DORM_DormantAll);
+		}
+		else
+		{
+			SetReplicates(false);
+		}
+		return;
+	}
+
+	Health = GetMaxHealth();
+	bIsTargeting = false;
+	bWantsToRun = false;
+	bWantsToRunToggled = false;
+	bWantsToFire = false;
+
+	UShooterCharacterMovement* MoveComp = Cast<UShooterCharacterMovement>(GetCharacterMovement());
+	if (MoveComp)
+	{
+		MoveComp->ResetMovementState();
+	}
+
+	// undo TurnOff from end of previous match, pawns parked alive by ResetMatch still have it applied
+	GetMesh()->bPauseAnims = false;
+	GetMesh()->bBlendPhysics = false;
+	GetMesh()->KinematicBonesUpdateType = EKinematicBonesUpdateToPhysics::SkipSimulatingBones;
+
+	// appearance left by previous life
+	UpdatePawnMeshes();
+	for (UMaterialInstanceDynamic* MID : MeshMIDs)
+	{
+		if (MID)
+		{
+			MID->SetScalarParameterValue(TEXT("IsFrozen"), 0.0f);
+		}
+	}
+	UpdateTeamColorsAllMIDs();
+
+	if (GetIsReplicated())
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+	else
+	{
+		SetReplicates(true);
+	}
+
+	GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::SpawnDefaultInventory);
+
+	UShooterEffectBudget* EffectBudget = UShooterEffectBudget::Get(this);
+	if (GetNetMode() != NM_DedicatedServer && EffectBudget)
 	{
 		if (RespawnFX)
 		{
-			UGameplayStatics::SpawnEmitterAtLocation(this, RespawnFX, GetActorLocation(), GetActorRotation());
+			EffectBudget->SpawnEmitterAtLocation(RespawnFX, GetActorLocation(), GetActorRotation(), GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
 		}
 
 		if (RespawnSound)
 		{
-			UGameplayStatics::PlaySoundAtLocation(this, RespawnSound, GetActorLocation());
+			EffectBudget->PlaySoundAtLocation(RespawnSound, GetActorLocation());
 		}
 	}
 }
 
+bool AShooterCharacter::IsPooled() const
+{
+	return bIsPooled;
+}
+
 void AShooterCharacter::Destroyed()
 {
 	Super::Destroyed();
 	DestroyInventory();
+
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (CharacterGrid)
+	{
+		CharacterGrid->UnregisterCharacter(this);
+	}
 }
 
 void AShooterCharacter::PawnClientRestart()
@@ -274,7 +396,7 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 	}
 	
 	// Handle freezing ammo
-	if((DamageEvent.DamageTypeClass->GetName()).Equals("DmgType_Freeze_C"))
+	if (UShooterDamageType::IsFreeze(DamageEvent.DamageTypeClass))
 	{
 		UShooterCharacterMovement* MoveComp = Cast<UShooterCharacterMovement>(GetCharacterMovement());
 		if(MoveComp) MoveComp->ServerSetFrozen(true);
@@ -514,7 +636,11 @@ void AShooterCharacter::SetRagdollPhysics()
 	}
 	else
 	{
-		SetLifeSpan(10.0f);
+		UShooterCorpseManager* CorpseManager = UShooterCorpseManager::Get(this);
+		if (CorpseManager == NULL || !CorpseManager->RegisterCorpse(this))
+		{
+			SetLifeSpan(10.0f);
+		}
 	}
 }
 
@@ -581,14 +707,25 @@ void AShooterCharacter::SpawnDefaultInventory()
 		return;
 	}
 
+	UShooterWeaponPool* WeaponPool = UShooterWeaponPool::Get(this);
+
 	int32 NumWeaponClasses = DefaultInventoryClasses.Num();
 	for (int32 i = 0; i < NumWeaponClasses; i++)
 	{
 		if (DefaultInventoryClasses[i])
 		{
-			FActorSpawnParameters SpawnInfo;
-			SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-			AShooterWeapon* NewWeapon = GetWorld()->SpawnActor<AShooterWeapon>(DefaultInventoryClasses[i], SpawnInfo);
+			AShooterWeapon* NewWeapon = NULL;
+			if (WeaponPool)
+			{
+				// reuse weapons of dead characters
+				NewWeapon = WeaponPool->AcquireWeapon(DefaultInventoryClasses[i]);
+			}
+			else
+			{
+				FActorSpawnParameters SpawnInfo;
+				SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				NewWeapon = GetWorld()->SpawnActor<AShooterWeapon>(DefaultInventoryClasses[i], SpawnInfo);
+			}
 			AddWeapon(NewWeapon);
 		}
 	}
@@ -607,27 +744,36 @@ void AShooterCharacter::DestroyInventory()
 		return;
 	}
 
-	// remove all weapons from inventory and destroy them
+	UShooterWeaponPool* WeaponPool = UShooterWeaponPool::Get(this);
+
+	// remove all weapons from inventory and return them to pool, or destroy them
 	for (int32 i = Inventory.Num() - 1; i >= 0; i--)
 	{
 		AShooterWeapon* Weapon = Inventory[i];
 		if (Weapon)
 		{
 			RemoveWeapon(Weapon);
-			Weapon->Destroy();
+			if (WeaponPool)
+			{
+				WeaponPool->ReleaseWeapon(Weapon);
+			}
+			else
+			{
+				Weapon->Destroy();
+			}
 		}
 	}
 }
 
 void AShooterCharacter::SpawnAmmo_Implementation()
 {
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = this;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AShooterPickup_Ammo* DroppedAmmo = Cast<AShooterPickup_Ammo>(GetWorld()->SpawnActor<AActor>(ShooterPickupDroppedAmmoClass, GetActorLocation(), GetActorRotation(), SpawnParams));
-	const int32 CurrentAmmo = GetInventoryWeapon(0)->GetCurrentAmmo();
-	DroppedAmmo->SetAmmoClips(CurrentAmmo / GetInventoryWeapon(0)->GetAmmoPerClip());
-	DroppedAmmo->SetAdditionalBullets(CurrentAmmo % GetInventoryWeapon(0)->GetAmmoPerClip());
+	// pool merges drops of characters dying close to each other and caps pickup count
+	UShooterDroppedAmmoPool* AmmoPool = UShooterDroppedAmmoPool::Get(this);
+	AShooterWeapon* Weapon = GetInventoryCount() > 0 ? GetInventoryWeapon(0) : NULL;
+	if (AmmoPool && Weapon)
+	{
+		AmmoPool->DropAmmo(ShooterPickupDroppedAmmoClass, GetActorLocation(), GetActorRotation(), Weapon->GetCurrentAmmo(), Weapon->GetAmmoPerClip());
+	}
 }
 
 bool AShooterCharacter::SpawnAmmo_Validate()
@@ -640,7 +786,7 @@ void AShooterCharacter::AddWeapon(AShooterWeapon* Weapon)
 	if (Weapon && GetLocalRole() == ROLE_Authority)
 	{
 		Weapon->OnEnterInventory(this);
-		Inventory.AddUnique(Weapon);
+		Inventory.Add(Weapon);
 	}
 }
 
@@ -649,7 +795,7 @@ void AShooterCharacter::RemoveWeapon(AShooterWeapon* Weapon)
 	if (Weapon && GetLocalRole() == ROLE_Authority)
 	{
 		Weapon->OnLeaveInventory();
-		Inventory.RemoveSingle(Weapon);
+		Inventory.Remove(Weapon);
 	}
 }
 
@@ -696,6 +842,17 @@ void AShooterCharacter::OnRep_CurrentWeapon(AShooterWeapon* LastWeapon)
 	SetCurrentWeapon(CurrentWeapon, LastWeapon);
 }
 
+void AShooterCharacter::OnInventoryReplicated()
+{
+	// only new weapons get ammo, others keep locally predicted clip
+	AmmoState.Apply(Inventory);
+}
+
+void AShooterCharacter::OnRep_AmmoState()
+{
+	AmmoState.Apply(Inventory);
+}
+
 void AShooterCharacter::SetCurrentWeapon(AShooterWeapon* NewWeapon, AShooterWeapon* LastWeapon)
 {
 	AShooterWeapon* LocalLastWeapon = nullptr;
@@ -1019,7 +1176,7 @@ void AShooterCharacter::OnNextWeapon()
 	{
 		if (Inventory.Num() >= 2 && (CurrentWeapon == NULL || CurrentWeapon->GetCurrentState() != EWeaponState::Equipping))
 		{
-			const int32 CurrentWeaponIdx = Inventory.IndexOfByKey(CurrentWeapon);
+			const int32 CurrentWeaponIdx = Inventory.IndexOf(CurrentWeapon);
 			AShooterWeapon* NextWeapon = Inventory[(CurrentWeaponIdx + 1) % Inventory.Num()];
 			EquipWeapon(NextWeapon);
 		}
@@ -1035,7 +1192,7 @@ void AShooterCharacter::OnPrevWeapon()
 	{
 		if (Inventory.Num() >= 2 && (CurrentWeapon == NULL || CurrentWeapon->GetCurrentState() != EWeaponState::Equipping))
 		{
-			const int32 CurrentWeaponIdx = Inventory.IndexOfByKey(CurrentWeapon);
+			const int32 CurrentWeaponIdx = Inventory.IndexOf(CurrentWeapon);
 			AShooterWeapon* PrevWeapon = Inventory[(CurrentWeaponIdx - 1 + Inventory.Num()) % Inventory.Num()];
 			EquipWeapon(PrevWeapon);
 		}
@@ -1262,6 +1419,14 @@ void AShooterCharacter::PreReplication(IRepChangedPropertyTracker & ChangedPrope
 
 	// Only replicate this property for a short duration after it changes so join in progress players don't get spammed with fx when joining late
 	DOREPLIFETIME_ACTIVE_OVERRIDE(AShooterCharacter, LastTakeHitInfo, GetWorld() && GetWorld()->GetTimeSeconds() < LastTakeHitTimeTimeout);
+
+	// gather ammo of all weapons, only changed slots are sent
+	// remote owner's burst is settled lazily, bring it up to date first
+	if (CurrentWeapon)
+	{
+		CurrentWeapon->UpdateServerBurst();
+	}
+	AmmoState.Update(Inventory);
 }
 
 void AShooterCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
@@ -1270,6 +1435,7 @@ void AShooterCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > &
 
 	// only to local owner: weapon change requests are locally instigated, other clients don't need it
 	DOREPLIFETIME_CONDITION(AShooterCharacter, Inventory, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(AShooterCharacter, AmmoState, COND_OwnerOnly);
 
 	// everyone except local owner: flag change is locally instigated
 	DOREPLIFETIME_CONDITION(AShooterCharacter, bIsTargeting, COND_SkipOwner);
@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterCharacterGrid.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Grid Update"), STAT_ShooterCharacterGridUpdate, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Character Grid Query"), STAT_ShooterCharacterGridQuery, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Character Grid Nearest Tests"), STAT_ShooterCharacterGridNearestTests, STATGROUP_ShooterGame);
+
+float CVar_ShooterCharacterGrid_CellSize = 1000.f;
+static FAutoConsoleVariableRef CVarShooterCharacterGridCellSize(TEXT("ShooterCharacterGrid.CellSize"), CVar_ShooterCharacterGrid_CellSize, TEXT("Size of character spatial hash cell"), ECVF_Default );
+
+UShooterCharacterGrid::UShooterCharacterGrid()
+{
+	BuiltCellSize = 0.0f;
+	BuiltFrame = 0;
+	BuiltMinCell = FIntPoint::ZeroValue;
+	BuiltMaxCell = FIntPoint::ZeroValue;
+}
+
+UShooterCharacterGrid* UShooterCharacterGrid::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterCharacterGrid>() : NULL;
+}
+
+void UShooterCharacterGrid::RegisterCharacter(AShooterCharacter* Character)
+{
+	Characters.AddUnique(Character);
+	BuiltFrame = 0;
+}
+
+void UShooterCharacterGrid::UnregisterCharacter(AShooterCharacter* Character)
+{
+	Characters.RemoveSwap(Character);
+	BuiltFrame = 0;
+}
+
+void UShooterCharacterGrid::QueryRadius(const FVector& Center, float Radius, TArray<AShooterCharacter*>& OutCharacters)
+{
+	UpdateCells();
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterGridQuery);
+
+	const float RadiusSq = FMath::Square(Radius);
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(CellX, CellY));
+			if (Cell == NULL)
+			{
+				continue;
+			}
+
+			for (int32 CharacterIdx : *Cell)
+			{
+				AShooterCharacter* Character = Characters[CharacterIdx].Get();
+				if (Character && FVector::DistSquared(Character->GetActorLocation(), Center) <= RadiusSq)
+				{
+					OutCharacters.Add(Character);
+				}
+			}
+		}
+	}
+}
+
+AShooterCharacter* UShooterCharacterGrid::FindNearest(const FVector& Location, TFunctionRef<bool(AShooterCharacter*)> Predicate, float MaxRadius)
+{
+	UpdateCells();
+
+	if (Characters.Num() == 0)
+	{
+		return NULL;
+	}
+
+	// ring search around origin's cell, limited by occupied area
+	const FIntPoint CenterCell = GetCell(Location);
+	int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(BuiltMinCell.X - CenterCell.X), FMath::Abs(BuiltMaxCell.X - CenterCell.X)),
+		FMath::Max(FMath::Abs(BuiltMinCell.Y - CenterCell.Y), FMath::Abs(BuiltMaxCell.Y - CenterCell.Y)));
+	if (MaxRadius / BuiltCellSize < MaxRing)
+	{
+		MaxRing = FMath::CeilToInt(MaxRadius / BuiltCellSize) + 1;
+	}
+
+	const float MaxRadiusSq = FMath::Square(MaxRadius);
+
+	// gathered but not tested yet, sorted with closest last
+	TArray<TPair<float, int32>, TInlineAllocator<32>> Pending;
+
+	auto GatherCell = [&](int32 CellX, int32 CellY)
+	{
+		const TArray<int32>* Cell = Cells.Find(FIntPoint(CellX, CellY));
+		if (Cell)
+		{
+			for (int32 CharacterIdx : *Cell)
+			{
+				const float DistSq = FVector::DistSquared(Characters[CharacterIdx]->GetActorLocation(), Location);
+				if (DistSq <= MaxRadiusSq)
+				{
+					Pending.Add(TPair<float, int32>(DistSq, CharacterIdx));
+				}
+			}
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterGridQuery);
+
+			if (Ring == 0)
+			{
+				GatherCell(CenterCell.X, CenterCell.Y);
+			}
+			else
+			{
+				for (int32 Offset = -Ring; Offset <= Ring; Offset++)
+				{
+					GatherCell(CenterCell.X + Offset, CenterCell.Y - Ring);
+					GatherCell(CenterCell.X + Offset, CenterCell.Y + Ring);
+				}
+				for (int32 Offset = -Ring + 1; Offset <= Ring - 1; Offset++)
+				{
+					GatherCell(CenterCell.X - Ring, CenterCell.Y + Offset);
+					GatherCell(CenterCell.X + Ring, CenterCell.Y + Offset);
+				}
+			}
+
+			Pending.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; });
+		}
+
+		// characters in further rings are at least Ring cells away, anything closer can be tested in order
+		const float SafeDistSq = (Ring == MaxRing) ? MAX_FLT : FMath::Square(Ring * BuiltCellSize);
+		while (Pending.Num() > 0 && Pending.Last().Key <= SafeDistSq)
+		{
+			AShooterCharacter* Character = Characters[Pending.Pop(false).Value].Get();
+			INC_DWORD_STAT(STAT_ShooterCharacterGridNearestTests);
+
+			if (Character && Predicate(Character))
+			{
+				return Character;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+void UShooterCharacterGrid::UpdateCells()
+{
+	if (BuiltFrame == GFrameCounter && BuiltCellSize == CVar_ShooterCharacterGrid_CellSize)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterGridUpdate);
+
+	BuiltFrame = GFrameCounter;
+	BuiltCellSize = FMath::Max(CVar_ShooterCharacterGrid_CellSize, 100.0f);
+
+	// keep allocated cells, characters tend to stay in the same area
+	for (TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+
+	Characters.RemoveAllSwap([](const TWeakObjectPtr<AShooterCharacter>& Character) { return !Character.IsValid(); });
+	for (int32 CharacterIdx = 0; CharacterIdx < Characters.Num(); CharacterIdx++)
+	{
+		const FIntPoint Cell = GetCell(Characters[CharacterIdx]->GetActorLocation());
+		Cells.FindOrAdd(Cell).Add(CharacterIdx);
+
+		BuiltMinCell = (CharacterIdx == 0) ? Cell : FIntPoint(FMath::Min(BuiltMinCell.X, Cell.X), FMath::Min(BuiltMinCell.Y, Cell.Y));
+		BuiltMaxCell = (CharacterIdx == 0) ? Cell : FIntPoint(FMath::Max(BuiltMaxCell.X, Cell.X), FMath::Max(BuiltMaxCell.Y, Cell.Y));
+	}
+}
+
+FIntPoint UShooterCharacterGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / BuiltCellSize), FMath::FloorToInt(Location.Y / BuiltCellSize));
+}
@@ -17,6 +17,7 @@ UShooterCharacterMovement::UShooterCharacterMovement(const FObjectInitializer& O
 	// Teleport
 	bWantsToTeleport = false;
 	TeleportDistance = 1000.0f;	// 100 unreal units = 1 meter
+	TeleportDirection = FVector::ZeroVector;
 	
 	// Jetpack
 	bIsJetpackActive = false;
@@ -86,9 +87,11 @@ void UShooterCharacterMovement::OnMovementUpdated(float DeltaSeconds, const FVec
 	if (bWantsToTeleport && (CharacterOwner->GetLocalRole() == ROLE_Authority || CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy))
 	{
 		// Teleport forward to the nearest non blocked location inside the TeleportDistance
-		const FVector NewLocation = PawnOwner->GetActorLocation() + PawnOwner->GetActorForwardVector() * TeleportDistance;
+		const FVector Direction = TeleportDirection.IsZero() ? PawnOwner->GetActorForwardVector() : TeleportDirection;
+		const FVector NewLocation = PawnOwner->GetActorLocation() + Direction * TeleportDistance;
 		PawnOwner->SetActorLocation(NewLocation, true);
 		bWantsToTeleport = false;
+		TeleportDirection = FVector::ZeroVector;
 	}
 
 
@@ -369,6 +372,27 @@ void UShooterCharacterMovement::SetWallRun(const bool bNewIsWallRunning, const F
 	}	
 }
 
+void UShooterCharacterMovement::ResetMovementState()
+{
+	bWantsToTeleport = false;
+	TeleportDirection = FVector::ZeroVector;
+
+	bWantsToJetpack = false;
+	bIsJetpackActive = false;
+	JetpackFuel = MaxJetpackFuel;
+
+	bWantsToWallRun = false;
+	bIsWallRunning = false;
+	WallNormal = FVector::ZeroVector;
+
+	// also clears frozen timer
+	ClearWallRunTimer();
+	bIsFrozen = false;
+
+	StopMovementImmediately();
+	SetMovementMode(MOVE_Walking);
+}
+
 void UShooterCharacterMovement::ClearWallRunTimer()
 {
 	GetWorld()->GetTimerManager().ClearTimer(WallRunTimerHandle);
@@ -386,6 +410,12 @@ void UShooterCharacterMovement::DoTeleport()
 	bWantsToTeleport = true;
 }
 
+void UShooterCharacterMovement::DoTeleportInDirection(const FVector& Direction)
+{
+	TeleportDirection = Direction;
+	bWantsToTeleport = true;
+}
+
 void UShooterCharacterMovement::UpdateFromCompressedFlags(uint8 Flags)
 {
 	Super::UpdateFromCompressedFlags(Flags);
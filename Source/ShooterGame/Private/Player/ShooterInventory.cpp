@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterInventory.h"
+#include "Algo/IsSorted.h"
+
+int32 FShooterInventory::IndexOf(const AShooterWeapon* Weapon) const
+{
+	return Items.IndexOfByPredicate([Weapon](const FShooterInventoryEntry& Entry) { return Entry.Weapon == Weapon; });
+}
+
+void FShooterInventory::Add(AShooterWeapon* Weapon)
+{
+	if (IndexOf(Weapon) == INDEX_NONE)
+	{
+		FShooterInventoryEntry& Entry = Items.AddDefaulted_GetRef();
+		Entry.Weapon = Weapon;
+		MarkItemDirty(Entry);
+	}
+}
+
+void FShooterInventory::Remove(AShooterWeapon* Weapon)
+{
+	const int32 Index = IndexOf(Weapon);
+	if (Index != INDEX_NONE)
+	{
+		Items.RemoveAt(Index);
+		MarkArrayDirty();
+	}
+}
+
+bool FShooterInventory::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FShooterInventoryEntry, FShooterInventory>(Items, DeltaParms, *this);
+
+	// owner is notified once per update, after order is restored; also when weapon references got resolved late
+	if (DeltaParms.Reader || DeltaParms.bUpdateUnmappedObjects)
+	{
+		// removed entries are swapped out on client, restore server's order (ids only grow, server removes in place)
+		const bool bSorted = Algo::IsSortedBy(Items, [](const FShooterInventoryEntry& Entry) { return Entry.ReplicationID; });
+		if (!bSorted)
+		{
+			Items.StableSort([](const FShooterInventoryEntry& A, const FShooterInventoryEntry& B) { return A.ReplicationID < B.ReplicationID; });
+			ItemMap.Reset();
+		}
+
+		if (Owner)
+		{
+			Owner->OnInventoryReplicated();
+		}
+	}
+
+	return bResult;
+}
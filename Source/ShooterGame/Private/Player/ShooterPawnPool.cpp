@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterPawnPool.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pawn Pool Acquire"), STAT_ShooterPawnPoolAcquire, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Pawn Pool Prewarm"), STAT_ShooterPawnPoolPrewarm, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Pawns"), STAT_ShooterPooledPawns, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pawns Reused"), STAT_ShooterPawnsReused, STATGROUP_ShooterGame);
+
+int32 CVar_ShooterPawnPool_SpawnsPerFrame = 1;
+static FAutoConsoleVariableRef CVarShooterPawnPoolSpawnsPerFrame(TEXT("ShooterPawnPool.SpawnsPerFrame"), CVar_ShooterPawnPool_SpawnsPerFrame, TEXT("Max number of pawns spawned per frame to fill pawn pool"), ECVF_Default );
+
+UShooterPawnPool* UShooterPawnPool::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterPawnPool>() : NULL;
+}
+
+void UShooterPawnPool::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_SpawnPrewarmedPawns);
+	}
+
+	for (const TPair<UClass*, FPawnBucket>& Bucket : Buckets)
+	{
+		DEC_DWORD_STAT_BY(STAT_ShooterPooledPawns, Bucket.Value.FreePawns.Num());
+	}
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterPawnPool::Prewarm(TSubclassOf<AShooterCharacter> PawnClass, int32 NumPawns)
+{
+	if (PawnClass == NULL)
+	{
+		return;
+	}
+
+	FPawnBucket& Bucket = Buckets.FindOrAdd(PawnClass);
+	Bucket.NumWanted = FMath::Max(NumPawns, 0);
+
+	UWorld* World = GetWorld();
+	if (World && !World->GetTimerManager().IsTimerActive(TimerHandle_SpawnPrewarmedPawns))
+	{
+		TimerHandle_SpawnPrewarmedPawns = World->GetTimerManager().SetTimerForNextTick(this, &UShooterPawnPool::SpawnPrewarmedPawns);
+	}
+}
+
+AShooterCharacter* UShooterPawnPool::AcquirePawn(TSubclassOf<AShooterCharacter> PawnClass, const FTransform& SpawnTransform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPawnPoolAcquire);
+
+	FPawnBucket* Bucket = Buckets.Find(PawnClass);
+	if (Bucket == NULL)
+	{
+		return NULL;
+	}
+
+	AShooterCharacter* Pawn = NULL;
+	while (Pawn == NULL && Bucket->FreePawns.Num() > 0)
+	{
+		Pawn = Bucket->FreePawns.Pop(false).Get();
+		DEC_DWORD_STAT(STAT_ShooterPooledPawns);
+
+		if (Pawn && Pawn->IsPendingKill())
+		{
+			Pawn = NULL;
+		}
+	}
+
+	if (Pawn)
+	{
+		INC_DWORD_STAT(STAT_ShooterPawnsReused);
+
+		Pawn->SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, NULL, ETeleportType::TeleportPhysics);
+		Pawn->SetPooled(false);
+
+		// refill in background
+		UWorld* World = GetWorld();
+		if (Bucket->NumWanted > 0 && !World->GetTimerManager().IsTimerActive(TimerHandle_SpawnPrewarmedPawns))
+		{
+			TimerHandle_SpawnPrewarmedPawns = World->GetTimerManager().SetTimerForNextTick(this, &UShooterPawnPool::SpawnPrewarmedPawns);
+		}
+	}
+
+	return Pawn;
+}
+
+void UShooterPawnPool::ReleasePawn(AShooterCharacter* Pawn)
+{
+	if (Pawn == NULL || Pawn->IsPendingKill() || Pawn->IsPooled() || !Pawn->IsAlive())
+	{
+		return;
+	}
+
+	Pawn->SetPooled(true);
+
+	FPawnBucket& Bucket = Buckets.FindOrAdd(Pawn->GetClass());
+	Bucket.FreePawns.Add(Pawn);
+	INC_DWORD_STAT(STAT_ShooterPooledPawns);
+}
+
+void UShooterPawnPool::SpawnPrewarmedPawns()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPawnPoolPrewarm);
+
+	UWorld* World = GetWorld();
+	int32 NumSpawned = 0;
+	bool bNeedsMore = false;
+
+	for (TPair<UClass*, FPawnBucket>& Bucket : Buckets)
+	{
+		while (Bucket.Value.FreePawns.Num() < Bucket.Value.NumWanted)
+		{
+			if (NumSpawned >= CVar_ShooterPawnPool_SpawnsPerFrame)
+			{
+				bNeedsMore = true;
+				break;
+			}
+
+			// parked before BeginPlay, so it is never replicated or added to character grid while idle
+			const FTransform SpawnTransform(FRotator::ZeroRotator, FVector::ZeroVector);
+			AShooterCharacter* Pawn = World->SpawnActorDeferred<AShooterCharacter>(Bucket.Key, SpawnTransform, NULL, NULL, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			NumSpawned++;
+			if (Pawn == NULL)
+			{
+				break;
+			}
+
+			Pawn->SetPooled(true);
+			Pawn->FinishSpawning(SpawnTransform);
+
+			// BeginPlay starts ticks of actor and movement again (bStartWithTickEnabled)
+			Pawn->SetActorTickEnabled(false);
+			Pawn->GetCharacterMovement()->SetComponentTickEnabled(false);
+
+			Bucket.Value.FreePawns.Add(Pawn);
+			INC_DWORD_STAT(STAT_ShooterPooledPawns);
+		}
+	}
+
+	if (bNeedsMore)
+	{
+		TimerHandle_SpawnPrewarmedPawns = World->GetTimerManager().SetTimerForNextTick(this, &UShooterPawnPool::SpawnPrewarmedPawns);
+	}
+}
@@ -5,6 +5,7 @@
 #include "Player/ShooterPlayerCameraManager.h"
 #include "Player/ShooterCheatManager.h"
 #include "Player/ShooterLocalPlayer.h"
+#include "Player/ShooterPawnPool.h"
 #include "Online/ShooterPlayerState.h"
 #include "Weapons/ShooterWeapon.h"
 #include "UI/Menu/ShooterIngameMenu.h"
@@ -340,6 +341,20 @@ void AShooterPlayerController::PawnPendingDestroy(APawn* P)
 	ClientSetSpectatorCamera(CameraLocation, CameraRotation);
 }
 
+void AShooterPlayerController::PawnLeavingGame()
+{
+	AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetPawn());
+	UShooterPawnPool* PawnPool = UShooterPawnPool::Get(this);
+	if (MyPawn && MyPawn->IsAlive() && PawnPool)
+	{
+		UnPossess();
+		PawnPool->ReleasePawn(MyPawn);
+		return;
+	}
+
+	Super::PawnLeavingGame();
+}
+
 void AShooterPlayerController::GameHasEnded(class AActor* EndGameFocus, bool bIsWinner)
 {
 	Super::GameHasEnded(EndGameFocus, bIsWinner);
@@ -832,6 +847,20 @@ void AShooterPlayerController::ClientGameEnded_Implementation(class AActor* EndG
 	bGameEndedFrame = true;
 }
 
+void AShooterPlayerController::ClientReset_Implementation()
+{
+	Super::ClientReset_Implementation();
+
+	AShooterHUD* ShooterHUD = GetShooterHUD();
+	if (ShooterHUD)
+	{
+		ShooterHUD->SetMatchState(EShooterMatchState::Warmup);
+		ShooterHUD->ShowScoreboard(false, true);
+	}
+
+	bGameEndedFrame = false;
+}
+
 void AShooterPlayerController::ClientSendRoundEndEvent_Implementation(bool bIsWinner, int32 ExpendedTimeInSeconds)
 {
 	const UWorld* World = GetWorld();
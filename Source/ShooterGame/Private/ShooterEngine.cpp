@@ -11,6 +11,9 @@
 UShooterEngine::UShooterEngine(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	NumExtraMatches = 0;
+	MatchPortStep = 1;
+	NumInstancedMaps = 0;
 }
 
 void UShooterEngine::Init(IEngineLoop* InEngineLoop)
@@ -18,6 +21,100 @@ void UShooterEngine::Init(IEngineLoop* InEngineLoop)
 	// Note: Lots of important things happen in Super::Init(), including spawning the player pawn in-game and
 	// creating the renderer.
 	Super::Init(InEngineLoop);
+
+	if (IsRunningDedicatedServer())
+	{
+		FParse::Value(FCommandLine::Get(), TEXT("ExtraMatches="), NumExtraMatches);
+		FParse::Value(FCommandLine::Get(), TEXT("ExtraMatchPortStep="), MatchPortStep);
+	}
+}
+
+bool UShooterEngine::LoadMap(FWorldContext& WorldContext, FURL URL, class UPendingNetGame* Pending, FString& Error)
+{
+	const bool bIsExtraMatch = ExtraMatchContexts.Contains(WorldContext.ContextHandle);
+	FString SourceMap = URL.Map;
+	if (bIsExtraMatch)
+	{
+		// package of same map may already be used by other match, travel (restart, servertravel) may name earlier instance
+		const FString* InstanceSource = InstancedMapSources.Find(URL.Map);
+		if (InstanceSource)
+		{
+			SourceMap = *InstanceSource;
+		}
+		URL.Map = InstanceMapPackage(SourceMap);
+	}
+
+	const int64 UsedMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	if (!Super::LoadMap(WorldContext, URL, Pending, Error))
+	{
+		return false;
+	}
+
+	if (bIsExtraMatch)
+	{
+		// instance package only exists in memory, later travel has to load from source map
+		WorldContext.LastURL.Map = SourceMap;
+	}
+
+	if (IsRunningDedicatedServer())
+	{
+		const int64 UsedMemoryAfter = FPlatformMemory::GetStats().UsedPhysical;
+		UE_LOG(LogShooter, Log, TEXT("Loaded %s on port %d, memory used by match %.1f MB"), *URL.Map, URL.Port, (UsedMemoryAfter - UsedMemoryBefore) / (1024.0 * 1024.0));
+	}
+
+	if (!bIsExtraMatch && ExtraMatchContexts.Num() < NumExtraMatches && IsRunningDedicatedServer())
+	{
+		StartExtraMatches(WorldContext, URL);
+	}
+
+	return true;
+}
+
+bool UShooterEngine::IsExtraMatchWorld(UWorld* World)
+{
+	UShooterEngine* ShooterEngine = Cast<UShooterEngine>(GEngine);
+	const FWorldContext* Context = (ShooterEngine && World) ? ShooterEngine->GetWorldContextFromWorld(World) : NULL;
+	return Context && ShooterEngine->ExtraMatchContexts.Contains(Context->ContextHandle);
+}
+
+void UShooterEngine::StartExtraMatches(FWorldContext& MainContext, const FURL& MainURL)
+{
+	for (int32 MatchIdx = ExtraMatchContexts.Num(); MatchIdx < NumExtraMatches; MatchIdx++)
+	{
+		// own world, game mode and game net driver (with its replication graph), ticked by engine with other contexts
+		FWorldContext& MatchContext = CreateNewWorldContext(EWorldType::Game);
+		MatchContext.OwningGameInstance = GameInstance;
+		ExtraMatchContexts.Add(MatchContext.ContextHandle);
+
+		FURL MatchURL(MainURL);
+		MatchURL.Port = MainURL.Port + (MatchIdx + 1) * MatchPortStep;
+
+		FString MatchError;
+		if (!LoadMap(MatchContext, MatchURL, NULL, MatchError))
+		{
+			UE_LOG(LogShooter, Error, TEXT("Failed to start extra match on port %d: %s"), MatchURL.Port, *MatchError);
+		}
+	}
+
+	// loading made last match current
+	GWorld = MainContext.World();
+}
+
+FString UShooterEngine::InstanceMapPackage(const FString& MapName)
+{
+	FString SourcePackageName = MapName;
+	if (FPackageName::IsShortPackageName(SourcePackageName))
+	{
+		FPackageName::SearchForPackageOnDisk(MapName, &SourcePackageName);
+	}
+
+	// same as level instances, package is loaded from source file under new name
+	const FString InstancePackageName = FString::Printf(TEXT("%s_Match%d"), *SourcePackageName, ++NumInstancedMaps);
+	LoadPackageAsync(InstancePackageName, NULL, *SourcePackageName);
+	FlushAsyncLoading();
+	InstancedMapSources.Add(InstancePackageName, SourcePackageName);
+
+	return InstancePackageName;
 }
 
 
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "Tests/ShooterTestControllerBotBenchmark.h"
+#include "ShooterGame.h"
+#include "Bots/ShooterAIController.h"
+
+void UShooterTestControllerBotBenchmark::OnInit()
+{
+	SampledTime   = 0.0f;
+	SampledFrames = 0;
+	MaxFrameTime  = 0.0f;
+	TimeSinceKill = 0.0f;
+	NumKills      = 0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("BotBenchmarkWarmup="), WarmupTime))
+	{
+		WarmupTime = 10.0f;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("BotBenchmarkDuration="), SampleDuration))
+	{
+		SampleDuration = 30.0f;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("BotBenchmarkKillInterval="), KillInterval))
+	{
+		KillInterval = 0.0f;
+	}
+}
+
+void UShooterTestControllerBotBenchmark::OnTick(float TimeDelta)
+{
+	if (GetTimeInCurrentState() > WarmupTime + SampleDuration + 300)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failing bot benchmark, match didn't start in time!"));
+		EndTest(-1);
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	AGameModeBase* GameMode = World ? World->GetAuthGameMode() : NULL;
+	AGameStateBase* GameState = World ? World->GetGameState() : NULL;
+	if (GameMode == NULL || GameState == NULL || !GameState->HasMatchStarted() || World->GetTimeSeconds() < WarmupTime)
+	{
+		return;
+	}
+
+	SampledTime += TimeDelta;
+	SampledFrames++;
+	MaxFrameTime = FMath::Max(MaxFrameTime, TimeDelta);
+
+	TimeSinceKill += TimeDelta;
+	if (KillInterval > 0.0f && TimeSinceKill >= KillInterval)
+	{
+		TimeSinceKill = 0.0f;
+		for (TActorIterator<AShooterCharacter> It(World); It; ++It)
+		{
+			if (It->IsAlive() && Cast<AShooterAIController>(It->GetController()))
+			{
+				It->KilledBy(NULL);
+				NumKills++;
+			}
+		}
+	}
+
+	if (SampledTime >= SampleDuration)
+	{
+		int32 NumBots = 0;
+		for (TActorIterator<AShooterAIController> It(World); It; ++It)
+		{
+			NumBots++;
+		}
+
+		UE_LOG(LogGauntlet, Display, TEXT("Bot benchmark: %d bots, %d kills, %d frames, avg frame %.2f ms, max frame %.2f ms"),
+			NumBots, NumKills, SampledFrames, SampledTime * 1000.0f / SampledFrames, MaxFrameTime * 1000.0f);
+		EndTest(0);
+	}
+}
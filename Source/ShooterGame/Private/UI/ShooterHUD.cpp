@@ -12,6 +12,9 @@
 #include "Misc/NetworkVersion.h"
 #include "OnlineSubsystemUtils.h"
 
+DECLARE_CYCLE_STAT(TEXT("HUD Draw"), STAT_ShooterHUDDraw, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Text Layouts"), STAT_ShooterHUDTextLayouts, STATGROUP_ShooterGame);
+
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
 const float AShooterHUD::MinHudScale = 0.5f;
@@ -178,27 +181,23 @@ void AShooterHUD::DrawWeaponHUD()
 			Canvas->DrawIcon(MyWeapon->PrimaryIcon, PriWeapPosX, PriWeapPosY, ScaleUI);
 
 			const float TextOffset = 12;
-			float SizeX, SizeY;
 			float TopTextHeight;
-			FString Text = FString::FromInt(MyWeapon->GetCurrentAmmoInClip());
-
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			const FHUDText& ClipAmmoText = UpdateHUDText(PrimaryClipAmmoText, MyWeapon->GetCurrentAmmoInClip(), BigFont);
 
 			const float TopTextScale = 0.73f; // of 51pt font
-			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
+			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + ClipAmmoText.Size.X * TopTextScale) / 2.0f)  * ScaleUI;
 			const float TopTextPosY = Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset - TextOffset / 2.0f) * ScaleUI; 
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = ClipAmmoText.Text;
 			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
-			TopTextHeight = SizeY * TopTextScale;
-			Text = FString::FromInt(MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip());
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			TopTextHeight = ClipAmmoText.Size.Y * TopTextScale;
+			const FHUDText& SpareAmmoText = UpdateHUDText(PrimarySpareAmmoText, MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip(), BigFont);
 
 			const float BottomTextScale = 0.49f; // of 51pt font
-			const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * BottomTextScale) / 2.0f) * ScaleUI; 
+			const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SpareAmmoText.Size.X * BottomTextScale) / 2.0f) * ScaleUI; 
 			const float BottomTextPosY = TopTextPosY + (TopTextHeight - 0.8f * TextOffset) * ScaleUI;
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = SpareAmmoText.Text;
 			TextItem.Scale = FVector2D( BottomTextScale*ScaleUI, BottomTextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			Canvas->DrawItem( TextItem, BottomTextPosX, BottomTextPosY );
@@ -298,18 +297,16 @@ void AShooterHUD::DrawWeaponHUD()
 			Canvas->DrawIcon(SecondaryWeapon->SecondaryIcon, SecWeapPosX, SecWeapPosY, ScaleUI);
 
 			const float TextOffset = 10;
-			float SizeX, SizeY;
 			float TopTextHeight;
-			FString Text = FString::FromInt(SecondaryWeapon->GetCurrentAmmo());
+			const FHUDText& AmmoText = UpdateHUDText(SecondaryAmmoText, SecondaryWeapon->GetCurrentAmmo(), BigFont);
 
-			Canvas->StrLen(BigFont,Text, SizeX, SizeY);
 			const float TopTextScale = 0.53f; // of 51pt font
-			TopTextHeight = SizeY * TopTextScale;
+			TopTextHeight = AmmoText.Size.Y * TopTextScale;
 
-			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (SecClipBoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
+			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (SecClipBoxWidth + AmmoText.Size.X * TopTextScale) / 2.0f)  * ScaleUI;
 			const float TopTextPosY = SecWeapBgPosY + (SecondaryWeapBg.VL - TopTextHeight) / 2.0f * ScaleUI; 
 
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = AmmoText.Text;
 			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
 			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
 		}
@@ -351,43 +348,51 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 	{
 		FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 		TextItem.EnableShadow( FLinearColor::Black );
-		float SizeX, SizeY;
 		float TextScale = 0.57f;
-		FString Text;
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.Scale = FVector2D( TextScale*ScaleUI, TextScale*ScaleUI );
 		if (MyGameState->GetMatchState() == MatchState::WaitingToStart)
 		{
+			// strings are keyed by remaining seconds, only made once per second
+			if (WarmupText.Value != MyGameState->RemainingTime || WarmupText.Font != BigFont)
+			{
+				UpdateHUDText(WarmupText, LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime), BigFont);
+				WarmupText.Value = MyGameState->RemainingTime;
+			}
+
 			TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-			Text = LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime);
 			TextItem.SetColor( HUDLight );
-			TextItem.Text = FText::FromString( Text );			
-			AddMatchInfoString(TextItem);
+			TextItem.Text = WarmupText.Text;
+			AddMatchInfoString(TextItem, WarmupText);
 		}
 		else if (MyGameState->GetMatchState() == MatchState::InProgress)
 		{
-			Text = GetTimeString(MyGameState->RemainingTime);
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			if (TimerText.Value != MyGameState->RemainingTime || TimerText.Font != BigFont)
+			{
+				UpdateHUDText(TimerText, GetTimeString(MyGameState->RemainingTime), BigFont);
+				TimerText.Value = MyGameState->RemainingTime;
+			}
 
 			TextItem.SetColor( HUDDark );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = TimerText.Text;
 			TextItem.Position = FVector2D( TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
-				TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				TimerPosY + (TimePlaceBg.VL * ScaleUI - TimerText.Size.Y * TextScale * ScaleUI) / 2 );
 			Canvas->DrawItem(TextItem);
 		}
 
 		float BoxWidth = 45.0f * ScaleUI;
-		Text = FString();
 		AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(PlayerOwner);
 		if (MyPC && MyGameState && MatchState == EShooterMatchState::Playing)
 		{
 			AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyPC->PlayerState);
 			if (MyPlayerState)
 			{
+				int32 MyPos = 0;
+				int32 NumPositions = 0;
 				if (MyGameState->NumTeams > 1) // team based game
 				{
 					int32 MyTeam = MyPlayerState->GetTeamNum();
-					int32 MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
+					MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
 					for (int32 i=0; i < MyGameState->TeamScores.Num(); i++)
 					{
 						if (MyGameState->TeamScores.Num() > MyTeam &&
@@ -396,36 +401,39 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 							MyPos--;
 						}
 					}
-					int32 NumTeams = 0;
 					for (int32 i=0; i < MyGameState->NumTeams; i++)
 					{
-						RankedPlayerMap PlayerStateMap;
-						MyGameState->GetRankedMap(i,PlayerStateMap);
-						if(PlayerStateMap.Num() > 0)
+						if (MyGameState->GetTeamRanking(i).Num() > 0)
 						{
-							NumTeams++;
+							NumPositions++;
 						}
 					}
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, NumTeams);
 				}
 				else // free for all
 				{
-					RankedPlayerMap PlayerStateMap;
-					MyGameState->GetRankedMap(0,PlayerStateMap);
-					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
+					// game state keeps ranking sorted, no need to build ranked map
+					const TArray<AShooterGameState::FRankedPlayer>& Ranking = MyGameState->GetTeamRanking(0);
+					const int32 MyRank = Ranking.IndexOfByPredicate([MyPlayerState](const AShooterGameState::FRankedPlayer& RankedPlayer) { return RankedPlayer.PlayerState.Get() == MyPlayerState; });
+					MyPos = MyRank + 1;
+					NumPositions = Ranking.Num();
+				}
+
+				const int32 PlaceKey = (MyPos << 16) | (NumPositions & 0xFFFF);
+				if (PlaceText.Value != PlaceKey || PlaceText.Font != BigFont)
+				{
+					UpdateHUDText(PlaceText, FString::Printf(TEXT("%d/%d"), MyPos, NumPositions), BigFont);
+					PlaceText.Value = PlaceKey;
 				}
-				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+
 				Canvas->DrawIcon(PlaceIcon,
-					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (SizeX * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
+					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (PlaceText.Size.X * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
 					TimerPosY + (TimePlaceBg.VL - PlaceIcon.VL) / 2.0f * ScaleUI, ScaleUI);
 
-				TextItem.Text = FText::FromString( Text);
+				TextItem.Text = PlaceText.Text;
 				TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 				TextItem.FontRenderInfo = ShadowedFont;
-				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + SizeX * TextScale * ScaleUI),
-					TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + PlaceText.Size.X * TextScale * ScaleUI),
+					TimerPosY + (TimePlaceBg.VL * ScaleUI - PlaceText.Size.Y * TextScale * ScaleUI) / 2 );
 			}
 		}
 	}
@@ -449,32 +457,22 @@ void AShooterHUD::DrawKills()
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 
-	float SizeX, SizeY;
-	FString Text = LOCTEXT("Kills", "KILLS:").ToString();
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+	const FHUDText& LabelText = UpdateHUDText(KillsLabelText, LOCTEXT("Kills", "KILLS:"), BigFont);
 
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = LabelText.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 	TextItem.FontRenderInfo = ShadowedFont;
 	TextItem.SetColor(HUDDark);
 	Canvas->DrawItem( TextItem, KillsPosX + Offset * ScaleUI + KillsIcon.UL * 1.5f * ScaleUI,
-		KillsPosY + (KillsBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+		KillsPosY + (KillsBg.VL * ScaleUI - LabelText.Size.Y * TextScale * ScaleUI) / 2 );
 
-	if (MyPlayerState)
-	{
-		Text = FString::FromInt(MyPlayerState->GetKills());
-	}
-	else 
-	{
-		Text = FString("0");
-	}
+	const FHUDText& ValueText = UpdateHUDText(KillsText, MyPlayerState->GetKills(), BigFont);
 	TextScale = 0.88f;
 	float BoxWidth = 135.0f * ScaleUI;
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = ValueText.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-	Canvas->DrawItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + SizeX * TextScale * ScaleUI) /2,
-		KillsPosY + (KillsBg.VL* ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+	Canvas->DrawItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + ValueText.Size.X * TextScale * ScaleUI) /2,
+		KillsPosY + (KillsBg.VL* ScaleUI - ValueText.Size.Y * TextScale * ScaleUI) / 2 );
 
 }
 
@@ -501,31 +499,27 @@ void AShooterHUD::DrawJetpackFuel()
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 
-	float SizeX, SizeY;
-	FString Text = LOCTEXT("Jetpack", "JETPACK").ToString();
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+	const FHUDText& LabelText = UpdateHUDText(JetpackLabelText, LOCTEXT("Jetpack", "JETPACK"), BigFont);
 
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = LabelText.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 	TextItem.FontRenderInfo = ShadowedFont;
 	TextItem.SetColor(HUDDark);
 
-	Canvas->DrawItem( TextItem, JetpackPosX + KillsBg.UL * ScaleUI - ((JetpackFuelBoxWidth/2 - 25) * ScaleUI) - (SizeX * TextScale * ScaleUI) / 2,
-        JetpackPosY + (KillsBg.VL* ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+	Canvas->DrawItem( TextItem, JetpackPosX + KillsBg.UL * ScaleUI - ((JetpackFuelBoxWidth/2 - 25) * ScaleUI) - (LabelText.Size.X * TextScale * ScaleUI) / 2,
+        JetpackPosY + (KillsBg.VL* ScaleUI - LabelText.Size.Y * TextScale * ScaleUI) / 2 );
 	
 	// Draw value of fuel left
-	if (MyPlayerState) Text = FString::FromInt(MyPlayerState->GetJetpackFuelLeft());
-	else Text = FString("0");
+	const FHUDText& ValueText = UpdateHUDText(JetpackFuelText, MyPlayerState->GetJetpackFuelLeft(), BigFont);
 	
 	TextScale = 0.88f;
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
 
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = ValueText.Text;
 	if(MyPlayerState->GetJetpackFuelLeft() == 0) TextItem.SetColor(FColor(200,0,0,255));
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 
 	Canvas->DrawItem( TextItem, JetpackPosX + Offset * ScaleUI + 1.5f * ScaleUI,
-        JetpackPosY + (KillsBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+        JetpackPosY + (KillsBg.VL * ScaleUI - ValueText.Size.Y * TextScale * ScaleUI) / 2 );
 
 }
 
@@ -541,6 +535,8 @@ void AShooterHUD::NotifyEnemyHit()
 
 void AShooterHUD::DrawHUD()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterHUDDraw);
+
 	Super::DrawHUD();
 	if (Canvas == nullptr)
 	{
@@ -568,8 +564,9 @@ void AShooterHUD::DrawHUD()
 	}
 
 
-	// Empty the info item array
-	InfoItems.Empty();
+	// Empty the info item array, keeping its allocation for next frame
+	InfoItems.Reset();
+	InfoItemSizes.Reset();
 	float TextScale = 1.0f;
 	// enforce min
 	ScaleUI = FMath::Max(ScaleUI, MinHudScale);
@@ -636,14 +633,13 @@ void AShooterHUD::DrawHUD()
 		else
 		{
 			// respawn
-			FString Text = LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN").ToString();
-			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
+			UpdateHUDText(RespawnText, LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN"), BigFont);
+			FCanvasTextItem TextItem( FVector2D::ZeroVector, RespawnText.Text, BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDLight);
-			AddMatchInfoString(TextItem);
+			AddMatchInfoString(TextItem, RespawnText);
 		}
 
 		DrawDeathMessages();
@@ -657,18 +653,15 @@ void AShooterHUD::DrawHUD()
 		const float CurrentTime = GetWorld()->GetTimeSeconds();
 		if (CurrentTime - NoAmmoNotifyTime >= 0 && CurrentTime - NoAmmoNotifyTime <= NoAmmoFadeOutTime)
 		{
-			FString Text = FString();
-
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - NoAmmoNotifyTime) / NoAmmoFadeOutTime);
-			Text = LOCTEXT("NoAmmo", "NO AMMO").ToString();
+			UpdateHUDText(NoAmmoText, LOCTEXT("NoAmmo", "NO AMMO"), BigFont);
 			
-			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
+			FCanvasTextItem TextItem( FVector2D::ZeroVector, NoAmmoText.Text, BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(FLinearColor(0.75f, 0.125f, 0.125f, Alpha ));
-			AddMatchInfoString(TextItem);			
+			AddMatchInfoString(TextItem, NoAmmoText);			
 		}
 	}
 
@@ -818,8 +811,8 @@ void AShooterHUD::DrawDeathMessages()
 	const FColor RedTeamColor = FColor(152, 70, 70, 255);
 	const FColor OwnerColor = HUDLight;
 
-	const FString KilledText = LOCTEXT("killed"," killed ").ToString();
-	FVector2D KilledTextSize(0.0f, 0.0f);
+	const FHUDText& KilledLabelText = UpdateHUDText(KilledText, LOCTEXT("killed"," killed "), NormalFont);
+	const FVector2D& KilledTextSize = KilledLabelText.Size;
 
 	const float GameTime = GetWorld()->GetTimeSeconds();
 	const float LinePadding = 6.0f;
@@ -831,25 +824,21 @@ void AShooterHUD::DrawDeathMessages()
 	// draw messages
 	float CurrentY = InitialY;
 
-	Canvas->StrLen(NormalFont, KilledText, KilledTextSize.X, KilledTextSize.Y);
-
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 	for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
 	{
-		const FDeathMessage& Message = DeathMessages[i];
+		FDeathMessage& Message = DeathMessages[i];
 		float CurrentX = InitialX;
-		FVector2D KillerSize(0.0f, 0.0f);
-		FVector2D VictimNameSize(0.0f, 0.0f);
 		float TextScale = 1.00f;
-		Canvas->StrLen(NormalFont, Message.KillerDesc, KillerSize.X, KillerSize.Y);
+		const FHUDText& KillerText = UpdateHUDText(Message.KillerText, Message.KillerDesc, NormalFont);
 		TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.SetColor(Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
 
-		TextItem.Text = FText::FromString( Message.KillerDesc );
+		TextItem.Text = KillerText.Text;
 		Canvas->DrawItem(TextItem, CurrentX, CurrentY);
-		CurrentX += KillerSize.X * TextScale * ScaleUI;
+		CurrentX += KillerText.Size.X * TextScale * ScaleUI;
 		
 		if (Message.DamageType.IsValid())
 		{
@@ -862,7 +851,7 @@ void AShooterHUD::DrawDeathMessages()
 		}
 		else
 		{
-			TextItem.Text = FText::FromString( KilledText );
+			TextItem.Text = KilledLabelText.Text;
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDDark);
@@ -873,8 +862,7 @@ void AShooterHUD::DrawDeathMessages()
 			
 		TextItem.SetColor(Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));		
 
-		Canvas->StrLen(NormalFont, Message.VictimDesc, VictimNameSize.X, VictimNameSize.Y);
-		TextItem.Text = FText::FromString( Message.VictimDesc );
+		TextItem.Text = UpdateHUDText(Message.VictimText, Message.VictimDesc, NormalFont).Text;
 		Canvas->DrawItem( TextItem, CurrentX, CurrentY );
 		CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
 	}
@@ -1159,6 +1147,46 @@ void AShooterHUD::AddChatLine(const FText& ChatString, bool bWantFocus)
 	}
 }
 
+const FHUDText& AShooterHUD::UpdateHUDText(FHUDText& HUDText, const FString& String, UFont* Font)
+{
+	if (HUDText.Font != Font || !HUDText.String.Equals(String, ESearchCase::CaseSensitive))
+	{
+		HUDText.Value = MIN_int32;
+		HUDText.String = String;
+		HUDText.Text = FText::FromString(String);
+		HUDText.Font = Font;
+		Canvas->StrLen(Font, String, HUDText.Size.X, HUDText.Size.Y);
+		INC_DWORD_STAT(STAT_ShooterHUDTextLayouts);
+	}
+	return HUDText;
+}
+
+const FHUDText& AShooterHUD::UpdateHUDText(FHUDText& HUDText, const FText& Text, UFont* Font)
+{
+	// compare display string, it changes with culture
+	const FString& String = Text.ToString();
+	if (HUDText.Font != Font || !HUDText.String.Equals(String, ESearchCase::CaseSensitive))
+	{
+		HUDText.Value = MIN_int32;
+		HUDText.String = String;
+		HUDText.Text = Text;
+		HUDText.Font = Font;
+		Canvas->StrLen(Font, String, HUDText.Size.X, HUDText.Size.Y);
+		INC_DWORD_STAT(STAT_ShooterHUDTextLayouts);
+	}
+	return HUDText;
+}
+
+const FHUDText& AShooterHUD::UpdateHUDText(FHUDText& HUDText, int32 Value, UFont* Font)
+{
+	if (HUDText.Value != Value || HUDText.Font != Font)
+	{
+		UpdateHUDText(HUDText, FString::FromInt(Value), Font);
+		HUDText.Value = Value;
+	}
+	return HUDText;
+}
+
 void AShooterHUD::MakeUV(FCanvasIcon& Icon, FVector2D& UV0, FVector2D& UV1, uint16 U, uint16 V, uint16 UL, uint16 VL)
 {
 	if (Icon.Texture)
@@ -1198,9 +1226,10 @@ bool AShooterHUD::IsMatchOver() const
 	return GetMatchState() == EShooterMatchState::Lost || GetMatchState() == EShooterMatchState::Won;
 }
 
-void AShooterHUD::AddMatchInfoString(const FCanvasTextItem InInfoItem )
+void AShooterHUD::AddMatchInfoString(const FCanvasTextItem InInfoItem, const FHUDText& InfoText)
 {
 	InfoItems.Add(InInfoItem);
+	InfoItemSizes.Add(InfoText.Size);
 }
 
 float AShooterHUD::ShowInfoItems(float YOffset, float TextScale)
@@ -1211,11 +1240,10 @@ float AShooterHUD::ShowInfoItems(float YOffset, float TextScale)
 	for (int32 iItem = 0; iItem < InfoItems.Num() ; iItem++)
 	{
 		float X = 0.0f;
-		float SizeX, SizeY; 
-		Canvas->StrLen(InfoItems[iItem].Font, InfoItems[iItem].Text.ToString(), SizeX, SizeY);
-		X = CanvasCentre - ( SizeX * InfoItems[iItem].Scale.X)/2.0f;
+		const FVector2D& Size = InfoItemSizes[iItem];
+		X = CanvasCentre - ( Size.X * InfoItems[iItem].Scale.X)/2.0f;
 		Canvas->DrawItem(InfoItems[iItem], X, Y);
-		Y += SizeY * InfoItems[iItem].Scale.Y;
+		Y += Size.Y * InfoItems[iItem].Scale.Y;
 	}
 	return Y;
 }
@@ -1231,18 +1259,18 @@ float AShooterHUD::DrawRecentlyKilledPlayer()
 		{
 			FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark);
 			TextItem.EnableShadow(FLinearColor::Black);
-			float SizeX, SizeY;
 			float TextScale = 0.71f;
-			FString Text = CenteredKillMessage.ToString();
+			const FHUDText& KillText = UpdateHUDText(CenteredKillText, CenteredKillMessage, BigFont);
+			const float SizeX = KillText.Size.X;
+			const float SizeY = KillText.Size.Y;
 
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - LastKillTime) / KillFadeOutTime);
 			TextItem.Font = BigFont;
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
 			Canvas->SetDrawColor(255, 255, 255, 255 * Alpha);
 			Canvas->DrawIcon(KilledIcon, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f,
 				DrawPos - (Offset * 4 - SizeY / 2 * TextScale + KilledIcon.VL / 2) * ScaleUI, ScaleUI);
 			TextItem.SetColor(FColor(HUDLight.R, HUDLight.G, HUDLight.B, HUDLight.A*Alpha));
-			TextItem.Text = FText::FromString(Text);
+			TextItem.Text = KillText.Text;
 			TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 			LastYPos = (DrawPos - (Offset * 4 * ScaleUI)) + SizeY;
 			Canvas->DrawItem(TextItem, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f + KilledIcon.UL * ScaleUI,
@@ -23,10 +23,13 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 	PCOwner = InArgs._PCOwner;
 	ScoreboardTint = FLinearColor(0.0f,0.0f,0.0f,0.4f);
 	ScoreBoxWidth = 140.0f;
+	ScoreListHeight = 640.0f;
 	ScoreCountUpTime = 2.0f;
+	PlayerTextColor = FShooterStyle::Get().GetWidgetStyle<FTextBlockStyle>("ShooterGame.DefaultScoreboard.Row.StatTextStyle").ColorAndOpacity;
 
 	ScoreboardStartTime = FPlatformTime::Seconds();
 	MatchState = InArgs._MatchState.Get();
+	RankingVersion = 0;
 
 	UpdatePlayerStateMaps();
 	
@@ -108,6 +111,7 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 		SAssignNew(ScoreboardData, SVerticalBox)
 	];
 	UpdateScoreboardGrid();
+	UpdateRowData();
 
 	SBorder::Construct(
 		SBorder::FArguments()
@@ -202,15 +206,31 @@ FText SShooterScoreboardWidget::GetMatchOutcomeText() const
 void SShooterScoreboardWidget::UpdateScoreboardGrid()
 {
 	ScoreboardData->ClearChildren();
+	TeamListViews.Reset();
+	TeamRowItems.SetNum(PlayerStateMaps.Num());
+
+	// lists only create rows for visible rank slots, so the scoreboard scales with player count
+	const float ListHeight = ScoreListHeight / FMath::Max(PlayerStateMaps.Num(), 1);
 	for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
 	{
+		TSharedPtr<SListView<TSharedPtr<FTeamPlayer>>> TeamListView;
+
 		//Player rows from each team
 		ScoreboardData->AddSlot() .AutoHeight()
 			[
-				MakePlayerRows(TeamNum)
+				SNew(SBox)
+				.MaxDesiredHeight(ListHeight)
+				[
+					SAssignNew(TeamListView, SListView<TSharedPtr<FTeamPlayer>>)
+					.SelectionMode(ESelectionMode::None)
+					.ListItemsSource(&TeamRowItems[TeamNum])
+					.OnGenerateRow(this, &SShooterScoreboardWidget::MakePlayerListRow)
+				]
 			];
+		TeamListViews.Add(TeamListView);
+
 		//If we have more than one team, we are playing team based game mode, add totals
-		if (PlayerStateMaps.Num() > 1 && PlayerStateMaps[TeamNum].Num() > 0)
+		if (PlayerStateMaps.Num() > 1)
 		{
 			// Horizontal Ruler
 			ScoreboardData->AddSlot() .AutoHeight() .Padding(NORM_PADDING)
@@ -218,10 +238,15 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 					SNew(SBorder)
 					.Padding(1)
 					.BorderImage(&ScoreboardStyle->ItemBorderBrush)
+					.Visibility(this, &SShooterScoreboardWidget::GetTeamTotalsVisibility, TeamNum)
 				];
 			ScoreboardData->AddSlot() .AutoHeight()
 				[
-					MakeTotalsRow(TeamNum)
+					SNew(SBox)
+					.Visibility(this, &SShooterScoreboardWidget::GetTeamTotalsVisibility, TeamNum)
+					[
+						MakeTotalsRow(TeamNum)
+					]
 				];
 		}
 	}
@@ -274,6 +299,8 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 				]
 			];
 	}
+
+	UpdateRowItems();
 }
 
 void SShooterScoreboardWidget::UpdatePlayerStateMaps()
@@ -281,42 +308,171 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 	if (PCOwner.IsValid())
 	{
 		AShooterGameState* const GameState = PCOwner->GetWorld()->GetGameState<AShooterGameState>();
-		if (GameState)
+		if (GameState && GameState->GetRankingVersion() != RankingVersion)
 		{
-			bool bRequiresWidgetUpdate = false;
+			RankingVersion = GameState->GetRankingVersion();
+
 			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
-			LastTeamPlayerCount.Reset();
-			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
-			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
+			const bool bTeamsChanged = (PlayerStateMaps.Num() != NumTeams);
+			PlayerStateMaps.SetNum(NumTeams);
+
+			for (int32 TeamNum = 0; TeamNum < NumTeams; TeamNum++)
+			{
+				// spectators don't get a row, so ranks map to list rows directly
+				RankedPlayerMap& PlayerStateMap = PlayerStateMaps[TeamNum];
+				PlayerStateMap.Reset();
+				for (const AShooterGameState::FRankedPlayer& RankedPlayer : GameState->GetTeamRanking(TeamNum))
+				{
+					if (RankedPlayer.PlayerState.IsValid() && !RankedPlayer.PlayerState->IsOnlyASpectator())
+					{
+						PlayerStateMap.Add(PlayerStateMap.Num(), RankedPlayer.PlayerState);
+					}
+				}
+			}
+
+			if (bTeamsChanged && ScoreboardData.IsValid())
+			{
+				UpdateScoreboardGrid();
+			}
+			UpdateRowItems();
+		}
+	}
+
+	UpdateSelectedPlayer();
+}
+
+void SShooterScoreboardWidget::UpdateRowItems()
+{
+	for (int32 TeamNum = 0; TeamNum < TeamRowItems.Num(); TeamNum++)
+	{
+		TArray<TSharedPtr<FTeamPlayer>>& RowItems = TeamRowItems[TeamNum];
+		const int32 NumRows = PlayerStateMaps.IsValidIndex(TeamNum) ? PlayerStateMaps[TeamNum].Num() : 0;
+		if (RowItems.Num() == NumRows)
+		{
+			continue;
+		}
+
+		// slots that stay keep their row widgets, rank changes only change what rows read
+		while (RowItems.Num() < NumRows)
+		{
+			RowItems.Add(MakeShareable(new FTeamPlayer(TeamNum, RowItems.Num())));
+		}
+		RowItems.SetNum(NumRows);
+
+		if (TeamListViews.IsValidIndex(TeamNum))
+		{
+			TeamListViews[TeamNum]->RequestListRefresh();
+		}
+	}
+}
+
+void SShooterScoreboardWidget::UpdateRowData()
+{
+	const APlayerState* OwnerPlayerState = PCOwner.IsValid() ? PCOwner->PlayerState : NULL;
+
+	TeamRowData.SetNum(PlayerStateMaps.Num());
+	TeamTotalValues.SetNum(PlayerStateMaps.Num());
+	TeamTotalTexts.SetNum(PlayerStateMaps.Num());
+
+	for (int32 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
+	{
+		const RankedPlayerMap& PlayerStateMap = PlayerStateMaps[TeamNum];
+		TArray<FScoreboardRowData>& Rows = TeamRowData[TeamNum];
+		Rows.SetNum(PlayerStateMap.Num());
+
+		int32 TeamTotal = 0;
+		for (int32 PlayerIdx = 0; PlayerIdx < Rows.Num(); PlayerIdx++)
+		{
+			FScoreboardRowData& Row = Rows[PlayerIdx];
+			AShooterPlayerState* PlayerState = PlayerStateMap.FindRef(PlayerIdx).Get();
+			if (Row.PlayerState != PlayerState)
 			{
-				LastTeamPlayerCount[i] = PlayerStateMaps[i].Num();
+				// different player in this slot, refresh all texts
+				Row.PlayerState = PlayerState;
+				Row.PlayerNameString.Reset();
+				Row.StatValues.Reset();
 			}
 
-			PlayerStateMaps.Reset();
-			PlayerStateMaps.AddZeroed(NumTeams);
-		
-			for (int32 i = 0; i < NumTeams; i++)
+			Row.bIsOwner = (PlayerState != NULL && PlayerState == OwnerPlayerState);
+			Row.bIsTalking = false;
+			if (PlayerState == NULL)
 			{
-				GameState->GetRankedMap(i, PlayerStateMaps[i]);
+				Row.PlayerName = FText::GetEmpty();
+				continue;
+			}
 
-				if (LastTeamPlayerCount.Num() > 0 && PlayerStateMaps[i].Num() != LastTeamPlayerCount[i])
+			const FUniqueNetIdRepl& PlayerUniqueId = PlayerState->GetUniqueId();
+			for (int32 i = 0; i < PlayersTalkingThisFrame.Num(); ++i)
+			{
+				if (PlayerUniqueId == PlayersTalkingThisFrame[i].Key && PlayersTalkingThisFrame[i].Value)
 				{
-					bRequiresWidgetUpdate = true;
+					Row.bIsTalking = true;
+					break;
 				}
 			}
-			if (bRequiresWidgetUpdate)
+
+			const FString PlayerName = PlayerState->GetShortPlayerName();
+			if (Row.PlayerNameString != PlayerName)
 			{
-				UpdateScoreboardGrid();
+				Row.PlayerNameString = PlayerName;
+				Row.PlayerName = FText::FromString(PlayerName);
+			}
+
+			if (Row.StatValues.Num() != Columns.Num())
+			{
+				Row.StatValues.Init(MIN_int32, Columns.Num());
+				Row.StatTexts.SetNum(Columns.Num());
+			}
+
+			// text is only formatted when value changes
+			for (int32 ColIdx = 0; ColIdx < Columns.Num(); ColIdx++)
+			{
+				const int32 StatValue = Columns[ColIdx].AttributeGetter.Execute(PlayerState);
+				const int32 ShownValue = LerpForCountup(StatValue);
+				if (Row.StatValues[ColIdx] != ShownValue)
+				{
+					Row.StatValues[ColIdx] = ShownValue;
+					Row.StatTexts[ColIdx] = FText::AsNumber(ShownValue);
+				}
+
+				if (ColIdx == Columns.Num() - 1)
+				{
+					TeamTotal += StatValue;
+				}
 			}
 		}
+
+		const int32 ShownTotal = LerpForCountup(TeamTotal);
+		if (TeamTotalValues[TeamNum] != ShownTotal || TeamTotalTexts[TeamNum].IsEmpty())
+		{
+			TeamTotalValues[TeamNum] = ShownTotal;
+			TeamTotalTexts[TeamNum] = FText::AsNumber(ShownTotal);
+		}
 	}
+}
 
-	UpdateSelectedPlayer();
+const FScoreboardRowData* SShooterScoreboardWidget::GetRowData(const FTeamPlayer& TeamPlayer) const
+{
+	if (TeamRowData.IsValidIndex(TeamPlayer.TeamNum) && TeamRowData[TeamPlayer.TeamNum].IsValidIndex(TeamPlayer.PlayerId))
+	{
+		return &TeamRowData[TeamPlayer.TeamNum][TeamPlayer.PlayerId];
+	}
+
+	return NULL;
+}
+
+void SShooterScoreboardWidget::ScrollSelectedPlayerIntoView()
+{
+	if (TeamListViews.IsValidIndex(SelectedPlayer.TeamNum) && TeamRowItems[SelectedPlayer.TeamNum].IsValidIndex(SelectedPlayer.PlayerId))
+	{
+		TeamListViews[SelectedPlayer.TeamNum]->RequestScrollIntoView(TeamRowItems[SelectedPlayer.TeamNum][SelectedPlayer.PlayerId]);
+	}
 }
 
 void SShooterScoreboardWidget::Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime )
 {
 	UpdatePlayerStateMaps();
+	UpdateRowData();
 }
 
 bool SShooterScoreboardWidget::SupportsKeyboardFocus() const
@@ -438,6 +594,7 @@ void SShooterScoreboardWidget::OnSelectedPlayerPrev()
 	check( SelectedPlayer.PlayerId != -1 );
 	SelectedPlayer.PlayerId = PrevPlayerId;
 	PlaySound(ScoreboardStyle->PlayerChangeSound);
+	ScrollSelectedPlayerIntoView();
 }
 
 void SShooterScoreboardWidget::OnSelectedPlayerNext()
@@ -481,6 +638,8 @@ void SShooterScoreboardWidget::OnSelectedPlayerNext()
 		SelectedPlayer.PlayerId = 0;
 		PlaySound(ScoreboardStyle->PlayerChangeSound);
 	}
+
+	ScrollSelectedPlayerIntoView();
 }
 
 void SShooterScoreboardWidget::ResetSelectedPlayer()
@@ -585,24 +744,14 @@ bool SShooterScoreboardWidget::ProfileUIOpened() const
 
 EVisibility SShooterScoreboardWidget::PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const
 {
-	return GetSortedPlayerState(TeamPlayer) ? EVisibility::Visible : EVisibility::Collapsed;
+	const FScoreboardRowData* Row = GetRowData(TeamPlayer);
+	return (Row && Row->PlayerState.IsValid()) ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
 EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const
 {
-	AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	if (PlayerState)
-	{
-		const FUniqueNetIdRepl& PlayerUniqueId = PlayerState->GetUniqueId();
-		for (int32 i = 0; i < PlayersTalkingThisFrame.Num(); ++i)
-		{
-			if (PlayerUniqueId == PlayersTalkingThisFrame[i].Key && PlayersTalkingThisFrame[i].Value)
-			{
-				return EVisibility::Visible;
-			}
-		}
-	}
-	return EVisibility::Hidden;
+	const FScoreboardRowData* Row = GetRowData(TeamPlayer);
+	return (Row && Row->bIsTalking) ? EVisibility::Visible : EVisibility::Hidden;
 }
 
 FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const
@@ -618,20 +767,13 @@ FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer
 
 FText SShooterScoreboardWidget::GetPlayerName(const FTeamPlayer TeamPlayer) const
 {
-	const AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	if (PlayerState)
-	{
-		return FText::FromString(PlayerState->GetShortPlayerName());
-	}
-
-	return FText::GetEmpty();
+	const FScoreboardRowData* Row = GetRowData(TeamPlayer);
+	return Row ? Row->PlayerName : FText::GetEmpty();
 }
 
-bool SShooterScoreboardWidget::ShouldPlayerBeDisplayed(const FTeamPlayer TeamPlayer) const
+EVisibility SShooterScoreboardWidget::GetTeamTotalsVisibility(uint8 TeamNum) const
 {
-	const AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	
-	return PlayerState != nullptr && !PlayerState->IsOnlyASpectator();
+	return (PlayerStateMaps.IsValidIndex(TeamNum) && PlayerStateMaps[TeamNum].Num() > 0) ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
 FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlayer) const
@@ -642,8 +784,7 @@ FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlaye
 		return FSlateColor(FLinearColor::Yellow);
 	}
 
-	const FTextBlockStyle& TextStyle = FShooterStyle::Get().GetWidgetStyle<FTextBlockStyle>("ShooterGame.DefaultScoreboard.Row.StatTextStyle");
-	return TextStyle.ColorAndOpacity;
+	return PlayerTextColor;
 }
 
 FSlateColor SShooterScoreboardWidget::GetColumnColor(const FTeamPlayer TeamPlayer, uint8 ColIdx) const
@@ -660,33 +801,24 @@ FSlateColor SShooterScoreboardWidget::GetColumnColor(const FTeamPlayer TeamPlaye
 
 bool SShooterScoreboardWidget::IsOwnerPlayer(const FTeamPlayer& TeamPlayer) const
 {
-	return ( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == GetSortedPlayerState(TeamPlayer) );
+	const FScoreboardRowData* Row = GetRowData(TeamPlayer);
+	return Row && Row->bIsOwner;
 }
 
-FText SShooterScoreboardWidget::GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const
+FText SShooterScoreboardWidget::GetStat(uint8 ColIdx, const FTeamPlayer TeamPlayer) const
 {
-	int32 StatTotal = 0;
-	if (TeamPlayer.PlayerId != SpecialPlayerIndex::All)
-	{
-		AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-		if (PlayerState)
-		{
-			StatTotal = Getter.Execute(PlayerState);
-		}
-	} 
-	else
+	const FScoreboardRowData* Row = GetRowData(TeamPlayer);
+	if (Row && Row->StatTexts.IsValidIndex(ColIdx))
 	{
-		for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[TeamPlayer.TeamNum]); PlayerIt; ++PlayerIt)
-		{
-			AShooterPlayerState* PlayerState = PlayerIt.Value().Get();
-			if (PlayerState)
-			{
-				StatTotal += Getter.Execute(PlayerState);
-			}
-		}
+		return Row->StatTexts[ColIdx];
 	}
 
-	return FText::AsNumber(LerpForCountup(StatTotal));
+	return FText::GetEmpty();
+}
+
+FText SShooterScoreboardWidget::GetTeamTotal(uint8 TeamNum) const
+{
+	return TeamTotalTexts.IsValidIndex(TeamNum) ? TeamTotalTexts[TeamNum] : FText::GetEmpty();
 }
 
 int32 SShooterScoreboardWidget::LerpForCountup(int32 ScoreValue) const
@@ -755,7 +887,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 			.HAlign(HAlign_Center)
 			[
 				SNew(STextBlock)
-				.Text(this, &SShooterScoreboardWidget::GetStat, Columns.Last().AttributeGetter, FTeamPlayer(TeamNum, SpecialPlayerIndex::All))
+				.Text(this, &SShooterScoreboardWidget::GetTeamTotal, TeamNum)
 				.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.HeaderTextStyle")
 			]
 		]
@@ -764,24 +896,13 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 	return TotalsRow.ToSharedRef();
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRows(uint8 TeamNum) const
+TSharedRef<ITableRow> SShooterScoreboardWidget::MakePlayerListRow(TSharedPtr<FTeamPlayer> Item, const TSharedRef<STableViewBase>& OwnerTable)
 {
-	TSharedRef<SVerticalBox> PlayerRows = SNew(SVerticalBox);
-
-	for (int32 PlayerIndex=0; PlayerIndex < PlayerStateMaps[TeamNum].Num(); PlayerIndex++ )
-	{
-		FTeamPlayer TeamPlayer(TeamNum, PlayerIndex);
-
-		if (ShouldPlayerBeDisplayed(TeamPlayer))
-		{
-			PlayerRows->AddSlot().AutoHeight()
-				[
-					MakePlayerRow(TeamPlayer)
-				];
-		}
-	}
-
-	return PlayerRows;
+	return
+		SNew(STableRow< TSharedPtr<FTeamPlayer> >, OwnerTable)
+		[
+			MakePlayerRow(*Item)
+		];
 }
 
 TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& TeamPlayer) const
@@ -837,7 +958,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 				.HAlign(HAlign_Center)
 				[
 					SNew(STextBlock)
-					.Text(this, &SShooterScoreboardWidget::GetStat, Columns[ColIdx].AttributeGetter, TeamPlayer)
+					.Text(this, &SShooterScoreboardWidget::GetStat, ColIdx, TeamPlayer)
 					.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
 					.ColorAndOpacity(this, &SShooterScoreboardWidget::GetColumnColor, TeamPlayer, ColIdx)
 				]
@@ -849,12 +970,8 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 
 AShooterPlayerState* SShooterScoreboardWidget::GetSortedPlayerState(const FTeamPlayer& TeamPlayer) const
 {
-	if (PlayerStateMaps.IsValidIndex(TeamPlayer.TeamNum) && PlayerStateMaps[TeamPlayer.TeamNum].Contains(TeamPlayer.PlayerId))
-	{
-		return PlayerStateMaps[TeamPlayer.TeamNum].FindRef(TeamPlayer.PlayerId).Get();
-	}
-	
-	return NULL;
+	const TWeakObjectPtr<AShooterPlayerState>* PlayerState = PlayerStateMaps.IsValidIndex(TeamPlayer.TeamNum) ? PlayerStateMaps[TeamPlayer.TeamNum].Find(TeamPlayer.PlayerId) : NULL;
+	return PlayerState ? PlayerState->Get() : NULL;
 }
 
 int32 SShooterScoreboardWidget::GetAttributeValue_Kills(AShooterPlayerState* PlayerState) const
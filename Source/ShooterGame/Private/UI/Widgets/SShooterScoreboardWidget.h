@@ -71,6 +71,33 @@ struct FTeamPlayer
 	}
 };
 
+struct FScoreboardRowData
+{
+	/** Player shown in the row */
+	TWeakObjectPtr<AShooterPlayerState> PlayerState;
+
+	/** Player name and its display text */
+	FString PlayerNameString;
+	FText PlayerName;
+
+	/** Last value and text of each column */
+	TArray<int32, TInlineAllocator<4>> StatValues;
+	TArray<FText, TInlineAllocator<4>> StatTexts;
+
+	/** Is it the owner player */
+	bool bIsOwner;
+
+	/** Is the player talking */
+	bool bIsTalking;
+
+	/** defaults */
+	FScoreboardRowData()
+		: bIsOwner(false)
+		, bIsTalking(false)
+	{
+	}
+};
+
 
 //class declare
 class SShooterScoreboardWidget : public SBorder
@@ -88,7 +115,7 @@ class SShooterScoreboardWidget : public SBorder
 	/** needed for every widget */
 	void Construct(const FArguments& InArgs);
 
-	/** update PlayerState maps with every tick when scoreboard is shown */
+	/** update PlayerState maps when ranking changed while scoreboard is shown */
 	virtual void Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime ) override;
 
 	/** if we want to receive focus */
@@ -105,14 +132,14 @@ class SShooterScoreboardWidget : public SBorder
 
 protected:
 
-	/** updates widgets when players leave or join */
+	/** builds team lists, only when number of teams changes */
 	void UpdateScoreboardGrid();
 
 	/** makes total row widget */
 	TSharedRef<SWidget> MakeTotalsRow(uint8 TeamNum) const;
 
-	/** makes player rows */
-	TSharedRef<SWidget> MakePlayerRows(uint8 TeamNum) const;
+	/** makes list row for player at rank slot, row is kept while slot exists */
+	TSharedRef<ITableRow> MakePlayerListRow(TSharedPtr<FTeamPlayer> Item, const TSharedRef<STableViewBase>& OwnerTable);
 
 	/** makes player row */
 	TSharedRef<SWidget> MakePlayerRow(const FTeamPlayer& TeamPlayer) const;
@@ -120,6 +147,18 @@ protected:
 	/** updates PlayerState maps to display accurate scores */
 	void UpdatePlayerStateMaps();
 
+	/** adds or removes rank slots of team lists to match PlayerState maps */
+	void UpdateRowItems();
+
+	/** caches names, stats and flags shown by rows, once per frame */
+	void UpdateRowData();
+
+	/** gets cached row data for specific team and player */
+	const FScoreboardRowData* GetRowData(const FTeamPlayer& TeamPlayer) const;
+
+	/** scrolls team list so the selected player is visible */
+	void ScrollSelectedPlayerIntoView();
+
 	/** gets ranked map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;
 
@@ -138,8 +177,8 @@ protected:
 	/** get player name */
 	FText GetPlayerName(const FTeamPlayer TeamPlayer) const;
 
-	/** get whether or not the player should be displayed on the scoreboard */
-	bool ShouldPlayerBeDisplayed(const FTeamPlayer TeamPlayer) const;
+	/** get team totals visibility */
+	EVisibility GetTeamTotalsVisibility(uint8 TeamNum) const;
 
 	/** get player color */
 	FSlateColor GetPlayerColor(const FTeamPlayer TeamPlayer) const;
@@ -150,8 +189,11 @@ protected:
 	/** checks to see if the specified player is the owner */
 	bool IsOwnerPlayer(const FTeamPlayer& TeamPlayer) const;
 
-	/** get specific stat for team number and optionally player */
-	FText GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const;
+	/** get specific stat for player */
+	FText GetStat(uint8 ColIdx, const FTeamPlayer TeamPlayer) const;
+
+	/** get team total of last stat */
+	FText GetTeamTotal(uint8 TeamNum) const;
 
 	/** linear interpolated score for match outcome animation */
 	int32 LerpForCountup(int32 ScoreValue) const;
@@ -210,6 +252,9 @@ protected:
 	/** width of scoreboard item */
 	int32 ScoreBoxWidth;
 
+	/** max height of player lists, split between teams */
+	float ScoreListHeight;
+
 	/** scoreboard count up time */
 	float ScoreCountUpTime;
 
@@ -219,11 +264,27 @@ protected:
 	/** the player currently selected in the scoreboard */
 	FTeamPlayer SelectedPlayer;
 
-	/** the Ranked PlayerState map...cleared every frame */
+	/** the Ranked PlayerState map...rebuilt when game state ranking changes, spectators excluded */
 	TArray<RankedPlayerMap> PlayerStateMaps;
 
-	/** player count in each team in the last tick */
-	TArray<int32> LastTeamPlayerCount;
+	/** game state ranking version PlayerStateMaps were built from */
+	uint32 RankingVersion;
+
+	/** rank slots listed by each team list, rows read player at their slot */
+	TArray<TArray<TSharedPtr<FTeamPlayer>>> TeamRowItems;
+
+	/** virtualized player list of each team */
+	TArray<TSharedPtr<SListView<TSharedPtr<FTeamPlayer>>>> TeamListViews;
+
+	/** row data of each team by rank */
+	TArray<TArray<FScoreboardRowData>> TeamRowData;
+
+	/** last team totals and their text */
+	TArray<int32> TeamTotalValues;
+	TArray<FText> TeamTotalTexts;
+
+	/** text color of rows of other players */
+	FSlateColor PlayerTextColor;
 
 	/** holds talking player data */
 	TArray<TPair<TSharedRef<const FUniqueNetId>, bool>> PlayersTalkingThisFrame;
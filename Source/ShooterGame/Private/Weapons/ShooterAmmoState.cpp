@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterAmmoState.h"
+#include "Weapons/ShooterWeapon.h"
+#include "Player/ShooterInventory.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ammo State Bits Sent"), STAT_ShooterAmmoStateBits, STATGROUP_ShooterGame);
+
+/** slot versions of state sent to connection, replication system keeps the last acked one */
+class FShooterAmmoDeltaState : public INetDeltaBaseState
+{
+public:
+
+	TArray<uint32> SlotVersions;
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		return SlotVersions == static_cast<FShooterAmmoDeltaState*>(OtherState)->SlotVersions;
+	}
+};
+
+/** zigzag encoding, small negative counts (clip of infinite clip weapons) stay small packed ints */
+static uint32 EncodeAmmoCount(int32 Count)
+{
+	return ((uint32)Count << 1) ^ (uint32)(Count >> 31);
+}
+
+static int32 DecodeAmmoCount(uint32 Encoded)
+{
+	return (int32)(Encoded >> 1) ^ -(int32)(Encoded & 1);
+}
+
+void FShooterAmmoState::Update(const FShooterInventory& Inventory)
+{
+	const int32 NumSlots = FMath::Min(Inventory.Num(), MaxSlots);
+	Slots.SetNum(NumSlots);
+
+	for (int32 SlotIdx = 0; SlotIdx < NumSlots; SlotIdx++)
+	{
+		const AShooterWeapon* Weapon = Inventory[SlotIdx];
+		const int32 Ammo = Weapon ? Weapon->GetCurrentAmmo() : 0;
+		const int32 AmmoInClip = Weapon ? Weapon->GetCurrentAmmoInClip() : 0;
+
+		FShooterAmmoSlot& Slot = Slots[SlotIdx];
+		if (Slot.Ammo != Ammo || Slot.AmmoInClip != AmmoInClip)
+		{
+			Slot.Ammo = Ammo;
+			Slot.AmmoInClip = AmmoInClip;
+			Slot.Version++;
+		}
+	}
+}
+
+void FShooterAmmoState::Apply(const FShooterInventory& Inventory)
+{
+	const int32 NumSlots = FMath::Min(Inventory.Num(), Slots.Num());
+	AppliedWeapons.SetNum(NumSlots);
+	AppliedVersions.SetNum(NumSlots);
+
+	for (int32 SlotIdx = 0; SlotIdx < NumSlots; SlotIdx++)
+	{
+		AShooterWeapon* Weapon = Inventory[SlotIdx];
+		const FShooterAmmoSlot& Slot = Slots[SlotIdx];
+		if (Weapon && (AppliedWeapons[SlotIdx].Get() != Weapon || AppliedVersions[SlotIdx] != Slot.Version))
+		{
+			Weapon->SetReplicatedAmmo(Slot.Ammo, Slot.AmmoInClip);
+			AppliedWeapons[SlotIdx] = Weapon;
+			AppliedVersions[SlotIdx] = Slot.Version;
+		}
+	}
+}
+
+bool FShooterAmmoState::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	if (DeltaParms.Writer)
+	{
+		// compare against last acked state: slots changed since are sent, lost packets are covered by the engine reverting base state
+		const FShooterAmmoDeltaState* OldState = DeltaParms.bInternalAck ? NULL : static_cast<FShooterAmmoDeltaState*>(DeltaParms.OldState);
+
+		TSharedPtr<FShooterAmmoDeltaState> NewState = MakeShareable(new FShooterAmmoDeltaState());
+		for (const FShooterAmmoSlot& Slot : Slots)
+		{
+			NewState->SlotVersions.Add(Slot.Version);
+		}
+		*DeltaParms.NewState = NewState;
+
+		if (OldState && OldState->SlotVersions == NewState->SlotVersions)
+		{
+			return false;
+		}
+
+		FBitWriter& Writer = *DeltaParms.Writer;
+		const int64 StartBits = Writer.GetNumBits();
+
+		uint32 NumSlots = Slots.Num();
+		Writer.SerializeInt(NumSlots, MaxSlots + 1);
+
+		for (int32 SlotIdx = 0; SlotIdx < Slots.Num(); SlotIdx++)
+		{
+			const bool bChanged = (OldState == NULL || !OldState->SlotVersions.IsValidIndex(SlotIdx) || OldState->SlotVersions[SlotIdx] != Slots[SlotIdx].Version);
+			Writer.WriteBit(bChanged);
+
+			if (bChanged)
+			{
+				// reserve is sent instead of total to keep it smaller, clip goes below zero for infinite clip weapons
+				const FShooterAmmoSlot& Slot = Slots[SlotIdx];
+				uint32 AmmoInClip = EncodeAmmoCount(Slot.AmmoInClip);
+				uint32 Reserve = EncodeAmmoCount(Slot.Ammo - Slot.AmmoInClip);
+				checkSlow(DecodeAmmoCount(AmmoInClip) + DecodeAmmoCount(Reserve) == Slot.Ammo);
+				Writer.SerializeIntPacked(AmmoInClip);
+				Writer.SerializeIntPacked(Reserve);
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_ShooterAmmoStateBits, Writer.GetNumBits() - StartBits);
+		return true;
+	}
+	else if (DeltaParms.Reader)
+	{
+		FBitReader& Reader = *DeltaParms.Reader;
+
+		uint32 NumSlots = 0;
+		Reader.SerializeInt(NumSlots, MaxSlots + 1);
+		Slots.SetNum(NumSlots);
+
+		for (FShooterAmmoSlot& Slot : Slots)
+		{
+			if (Reader.ReadBit())
+			{
+				uint32 AmmoInClip = 0;
+				uint32 Reserve = 0;
+				Reader.SerializeIntPacked(AmmoInClip);
+				Reader.SerializeIntPacked(Reserve);
+
+				Slot.AmmoInClip = DecodeAmmoCount(AmmoInClip);
+				Slot.Ammo = Slot.AmmoInClip + DecodeAmmoCount(Reserve);
+				Slot.Version++;
+			}
+		}
+
+		return !Reader.IsError();
+	}
+
+	// no object references to map
+	return false;
+}
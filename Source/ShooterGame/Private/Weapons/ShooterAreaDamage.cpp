@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterAreaDamage.h"
+#include "Player/ShooterCharacterGrid.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Area Damage Occlusion Traces"), STAT_ShooterAreaDamageTraces, STATGROUP_ShooterGame);
+
+UShooterAreaDamage* UShooterAreaDamage::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterAreaDamage>() : NULL;
+}
+
+void UShooterAreaDamage::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency(UShooterCharacterGrid::StaticClass());
+	Super::Initialize(Collection);
+
+	OcclusionTraceDelegate.BindUObject(this, &UShooterAreaDamage::OnOcclusionTraceCompleted);
+}
+
+void UShooterAreaDamage::Deinitialize()
+{
+	OcclusionTraceDelegate.Unbind();
+	PendingExplosions.Empty();
+	PendingVictims.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterAreaDamage::ApplyRadialDamage(float BaseDamage, const FVector& Origin, float Radius, TSubclassOf<UDamageType> DamageType, AActor* DamageCauser, AController* InstigatedBy)
+{
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (CharacterGrid == NULL || BaseDamage <= 0.0f || Radius <= 0.0f)
+	{
+		return;
+	}
+
+	TArray<AShooterCharacter*> Characters;
+	CharacterGrid->QueryRadius(Origin, Radius, Characters);
+	if (Characters.Num() == 0)
+	{
+		return;
+	}
+
+	FPendingExplosion Explosion;
+	Explosion.BaseDamage = BaseDamage;
+	Explosion.Origin = Origin;
+	Explosion.Radius = Radius;
+	Explosion.DamageType = DamageType ? DamageType : TSubclassOf<UDamageType>(UDamageType::StaticClass());
+	Explosion.DamageCauser = DamageCauser;
+	Explosion.InstigatedBy = InstigatedBy;
+	Explosion.NumPendingTraces = 0;
+	const int32 ExplosionIndex = PendingExplosions.Add(Explosion);
+
+	UWorld* World = GetWorld();
+	for (AShooterCharacter* Character : Characters)
+	{
+		if (!Character->IsAlive())
+		{
+			continue;
+		}
+
+		FPendingVictim Victim;
+		Victim.ExplosionIndex = ExplosionIndex;
+		Victim.Character = Character;
+		const int32 VictimIndex = PendingVictims.Add(Victim);
+
+		// anything blocking between origin and character center occludes it
+		FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(ShooterAreaDamage), true, DamageCauser);
+		TraceParams.AddIgnoredActor(Character);
+
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Test, Origin, Character->GetActorLocation(), ECC_Visibility, TraceParams,
+			FCollisionResponseParams::DefaultResponseParam, &OcclusionTraceDelegate, VictimIndex);
+
+		PendingExplosions[ExplosionIndex].NumPendingTraces++;
+		INC_DWORD_STAT(STAT_ShooterAreaDamageTraces);
+	}
+
+	if (PendingExplosions[ExplosionIndex].NumPendingTraces == 0)
+	{
+		PendingExplosions.RemoveAt(ExplosionIndex);
+	}
+}
+
+void UShooterAreaDamage::OnOcclusionTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const int32 VictimIndex = (int32)Datum.UserData;
+	if (!PendingVictims.IsValidIndex(VictimIndex))
+	{
+		return;
+	}
+
+	// copy and release slots right away, damage events may queue new explosions
+	const FPendingVictim Victim = PendingVictims[VictimIndex];
+	PendingVictims.RemoveAt(VictimIndex);
+
+	const FPendingExplosion Explosion = PendingExplosions[Victim.ExplosionIndex];
+	if (--PendingExplosions[Victim.ExplosionIndex].NumPendingTraces == 0)
+	{
+		PendingExplosions.RemoveAt(Victim.ExplosionIndex);
+	}
+
+	// test traces report blocking hit as single entry
+	const bool bOccluded = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+	if (!bOccluded && Victim.Character.IsValid())
+	{
+		DamageCharacter(Explosion, Victim.Character.Get());
+	}
+}
+
+void UShooterAreaDamage::DamageCharacter(const FPendingExplosion& Explosion, AShooterCharacter* Character)
+{
+	// match UGameplayStatics::ApplyRadialDamage: single component hit at its center, linear falloff
+	UPrimitiveComponent* CapsuleComp = Character->GetCapsuleComponent();
+	const FVector HitLocation = CapsuleComp->GetComponentLocation();
+	const FVector HitNormal = (Explosion.Origin - HitLocation).GetSafeNormal();
+
+	FRadialDamageEvent DamageEvent;
+	DamageEvent.DamageTypeClass = Explosion.DamageType;
+	DamageEvent.Origin = Explosion.Origin;
+	DamageEvent.Params = FRadialDamageParams(Explosion.BaseDamage, 0.0f, 0.0f, Explosion.Radius, 1.0f);
+	DamageEvent.ComponentHits.Add(FHitResult(Character, CapsuleComp, HitLocation, HitNormal));
+
+	Character->TakeDamage(Explosion.BaseDamage, DamageEvent, Explosion.InstigatedBy.Get(), Explosion.DamageCauser.Get());
+}
@@ -5,4 +5,29 @@
 
 UShooterDamageType::UShooterDamageType(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
-}
\ No newline at end of file
+	bFreeze = false;
+}
+
+bool UShooterDamageType::IsFreeze(TSubclassOf<UDamageType> DamageTypeClass)
+{
+	if (DamageTypeClass == NULL)
+	{
+		return false;
+	}
+
+	const UShooterDamageType* ShooterDamageType = Cast<UShooterDamageType>(DamageTypeClass->GetDefaultObject());
+	if (ShooterDamageType)
+	{
+		return ShooterDamageType->bFreeze;
+	}
+
+	// freeze damage type asset predating the flag, resolved once per class
+	static TMap<TWeakObjectPtr<UClass>, bool> LegacyFreezeTypes;
+	bool* bCachedFreeze = LegacyFreezeTypes.Find(DamageTypeClass.Get());
+	if (bCachedFreeze == NULL)
+	{
+		bCachedFreeze = &LegacyFreezeTypes.Add(DamageTypeClass.Get(), DamageTypeClass->GetName().Equals(TEXT("DmgType_Freeze_C")));
+	}
+
+	return *bCachedFreeze;
+}
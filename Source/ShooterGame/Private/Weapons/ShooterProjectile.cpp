@@ -12,7 +12,8 @@ AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializ
 	CollisionComp->AlwaysLoadOnClient = true;
 	CollisionComp->AlwaysLoadOnServer = true;
 	CollisionComp->bTraceComplexOnMove = true;
-	CollisionComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	// collision is swept by projectile manager, visual just flies until told to explode
+	CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	CollisionComp->SetCollisionObjectType(COLLISION_PROJECTILE);
 	CollisionComp->SetCollisionResponseToAllChannels(ECR_Ignore);
 	CollisionComp->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
@@ -34,16 +35,16 @@ AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializ
 
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
-	SetRemoteRoleForBackwardsCompat(ROLE_SimulatedProxy);
-	bReplicates = true;
-	SetReplicatingMovement(true);
+	bReplicates = false;
+
+	bExploded = false;
+	PredictionError = FVector::ZeroVector;
+	PredictionBlendTimeLeft = 0.0f;
 }
 
 void AShooterProjectile::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
-	MovementComp->OnProjectileStop.AddDynamic(this, &AShooterProjectile::OnImpact);
-	CollisionComp->MoveIgnoreActors.Add(GetInstigator());
 
 	AShooterWeapon_Projectile* OwnerWeapon = Cast<AShooterWeapon_Projectile>(GetOwner());
 	if (OwnerWeapon)
@@ -52,7 +53,6 @@ void AShooterProjectile::PostInitializeComponents()
 	}
 
 	SetLifeSpan( WeaponConfig.ProjectileLife );
-	MyController = GetInstigatorController();
 }
 
 void AShooterProjectile::InitVelocity(FVector& ShootDirection)
@@ -63,29 +63,75 @@ void AShooterProjectile::InitVelocity(FVector& ShootDirection)
 	}
 }
 
-void AShooterProjectile::OnImpact(const FHitResult& HitResult)
+void AShooterProjectile::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (PredictionBlendTimeLeft > 0.0f && !bExploded)
+	{
+		const float BlendAlpha = FMath::Min(DeltaSeconds / PredictionBlendTimeLeft, 1.0f);
+		const FVector Correction = PredictionError * BlendAlpha;
+
+		AddActorWorldOffset(Correction);
+		PredictionError -= Correction;
+		PredictionBlendTimeLeft -= DeltaSeconds;
+	}
+}
+
+void AShooterProjectile::EnablePredictionCollision()
+{
+	CollisionComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	CollisionComp->MoveIgnoreActors.Add(GetInstigator());
+	CollisionComp->MoveIgnoreActors.Add(GetOwner());
+}
+
+void AShooterProjectile::BlendToServer(const FVector& ServerLocation, const FVector& ServerDirection, float BlendTime)
 {
-	if (GetLocalRole() == ROLE_Authority && !bExploded)
+	// server projectile is swept by projectile manager, visual flies again if prediction stopped at wall
+	CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	if (MovementComp->UpdatedComponent == NULL)
+	{
+		MovementComp->SetUpdatedComponent(CollisionComp);
+	}
+
+	FVector ShootDirection = ServerDirection;
+	InitVelocity(ShootDirection);
+
+	PredictionError = ServerLocation - GetActorLocation();
+	PredictionBlendTimeLeft = BlendTime;
+
+	if (BlendTime <= 0.0f)
 	{
-		Explode(HitResult);
-		DisableAndDestroy();
+		SetActorLocation(ServerLocation);
+		PredictionError = FVector::ZeroVector;
 	}
 }
 
+float AShooterProjectile::GetInitialSpeed() const
+{
+	return MovementComp ? MovementComp->InitialSpeed : 0.0f;
+}
+
+float AShooterProjectile::GetCollisionRadius() const
+{
+	return CollisionComp ? CollisionComp->GetScaledSphereRadius() : 0.0f;
+}
+
 void AShooterProjectile::Explode(const FHitResult& Impact)
 {
+	if (bExploded)
+	{
+		return;
+	}
+
 	if (ParticleComp)
 	{
 		ParticleComp->Deactivate();
 	}
 
-	// effects and damage origin shouldn't be placed inside mesh at impact point
+	// effects shouldn't be placed inside mesh at impact point
 	const FVector NudgedImpactLocation = Impact.ImpactPoint + Impact.ImpactNormal * 10.0f;
-
-	if (WeaponConfig.ExplosionDamage > 0 && WeaponConfig.ExplosionRadius > 0 && WeaponConfig.DamageType)
-	{
-		UGameplayStatics::ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, NudgedImpactLocation, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, TArray<AActor*>(), this, MyController.Get());
-	}
+	SetActorLocation(Impact.ImpactPoint);
 
 	if (ExplosionTemplate)
 	{
@@ -99,6 +145,7 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 	}
 
 	bExploded = true;
+	DisableAndDestroy();
 }
 
 void AShooterProjectile::DisableAndDestroy()
@@ -111,41 +158,6 @@ void AShooterProjectile::DisableAndDestroy()
 
 	MovementComp->StopMovementImmediately();
 
-	// give clients some time to show explosion
+	// give effects some time to finish
 	SetLifeSpan( 2.0f );
 }
-
-///CODE_SNIPPET_START: AActor::GetActorLocation AActor::GetActorRotation
-void AShooterProjectile::OnRep_Exploded()
-{
-	FVector ProjDirection = GetActorForwardVector();
-
-	const FVector StartTrace = GetActorLocation() - ProjDirection * 200;
-	const FVector EndTrace = GetActorLocation() + ProjDirection * 150;
-	FHitResult Impact;
-	
-	if (!GetWorld()->LineTraceSingleByChannel(Impact, StartTrace, EndTrace, COLLISION_PROJECTILE, FCollisionQueryParams(SCENE_QUERY_STAT(ProjClient), true, GetInstigator())))
-	{
-		// failsafe
-		Impact.ImpactPoint = GetActorLocation();
-		Impact.ImpactNormal = -ProjDirection;
-	}
-
-	Explode(Impact);
-}
-///CODE_SNIPPET_END
-
-void AShooterProjectile::PostNetReceiveVelocity(const FVector& NewVelocity)
-{
-	if (MovementComp)
-	{
-		MovementComp->Velocity = NewVelocity;
-	}
-}
-
-void AShooterProjectile::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
-{
-	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
-	
-	DOREPLIFETIME( AShooterProjectile, bExploded );
-}
\ No newline at end of file
@@ -0,0 +1,499 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterProjectileManager.h"
+#include "Weapons/ShooterProjectile.h"
+#include "Weapons/ShooterAreaDamage.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Simulation"), STAT_ShooterProjectileTick, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Projectiles"), STAT_ShooterProjectilesSimulated, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Visual Projectiles"), STAT_ShooterProjectilesVisual, STATGROUP_ShooterGame);
+
+/** how long exploded projectiles stay in stream, so clients can show explosion */
+static const float ExplodedLingerTime = 2.0f;
+
+float CVar_ShooterProjectile_PredictionTimeout = 1.0f;
+static FAutoConsoleVariableRef CVarShooterProjectilePredictionTimeout(TEXT("ShooterProjectile.PredictionTimeout"), CVar_ShooterProjectile_PredictionTimeout, TEXT("Time to wait for server projectile before predicted one is removed"), ECVF_Default );
+
+float CVar_ShooterProjectile_PredictionBlendTime = 0.15f;
+static FAutoConsoleVariableRef CVarShooterProjectilePredictionBlendTime(TEXT("ShooterProjectile.PredictionBlendTime"), CVar_ShooterProjectile_PredictionBlendTime, TEXT("Time to blend predicted projectile into server position"), ECVF_Default );
+
+//////////////////////////////////////////////////////////////////////////
+// FShooterProjectileEvent
+
+void FShooterProjectileEvent::PostReplicatedAdd(const FShooterProjectileStream& InArraySerializer)
+{
+	UShooterProjectileManager* Manager = UShooterProjectileManager::Get(InArraySerializer.Owner);
+	if (Manager)
+	{
+		Manager->OnProjectileAdded(*this);
+	}
+}
+
+void FShooterProjectileEvent::PostReplicatedChange(const FShooterProjectileStream& InArraySerializer)
+{
+	UShooterProjectileManager* Manager = UShooterProjectileManager::Get(InArraySerializer.Owner);
+	if (Manager)
+	{
+		Manager->OnProjectileChanged(*this);
+	}
+}
+
+void FShooterProjectileEvent::PreReplicatedRemove(const FShooterProjectileStream& InArraySerializer)
+{
+	UShooterProjectileManager* Manager = UShooterProjectileManager::Get(InArraySerializer.Owner);
+	if (Manager)
+	{
+		Manager->OnProjectileRemoved(*this);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UShooterProjectileManager
+
+UShooterProjectileManager::UShooterProjectileManager()
+{
+	NextProjectileId = 0;
+}
+
+UShooterProjectileManager* UShooterProjectileManager::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterProjectileManager>() : NULL;
+}
+
+void UShooterProjectileManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const int32 ExpectedProjectiles = 256;
+	ProjectileIds.Reserve(ExpectedProjectiles);
+	Locations.Reserve(ExpectedProjectiles);
+	Velocities.Reserve(ExpectedProjectiles);
+	Radii.Reserve(ExpectedProjectiles);
+	ExpireTimes.Reserve(ExpectedProjectiles);
+	Params.Reserve(ExpectedProjectiles);
+
+	SweepDelegate.BindUObject(this, &UShooterProjectileManager::OnSweepCompleted);
+}
+
+void UShooterProjectileManager::Deinitialize()
+{
+	SweepDelegate.Unbind();
+
+	ProjectileIds.Empty();
+	Locations.Empty();
+	Velocities.Empty();
+	Radii.Empty();
+	ExpireTimes.Empty();
+	Params.Empty();
+	IdToIndex.Empty();
+	Visuals.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UShooterProjectileManager::IsTickable() const
+{
+	// only server simulates, visual actors move on their own
+	const UWorld* World = GetWorld();
+	return World && (World->GetNetMode() != NM_Client || PredictedProjectiles.Num() > 0) && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UShooterProjectileManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterProjectileManager, STATGROUP_Tickables);
+}
+
+UWorld* UShooterProjectileManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterProjectileManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterProjectileTick);
+
+	UWorld* World = GetWorld();
+	const float TimeSeconds = World->GetTimeSeconds();
+
+	if (World->GetNetMode() == NM_Client)
+	{
+		ExpirePredictedProjectiles();
+		return;
+	}
+
+	// drop projectiles which lived long enough
+	for (int32 Idx = ProjectileIds.Num() - 1; Idx >= 0; Idx--)
+	{
+		if (TimeSeconds >= ExpireTimes[Idx])
+		{
+			RemoveProjectile(Idx);
+		}
+	}
+
+	// move all, sweeps are resolved together with other async traces and reported in next frame
+	for (int32 Idx = 0; Idx < ProjectileIds.Num(); Idx++)
+	{
+		const FVector StartLocation = Locations[Idx];
+		const FVector EndLocation = StartLocation + Velocities[Idx] * DeltaTime;
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterProjectile), true, Params[Idx].Instigator.Get());
+		World->AsyncSweepByChannel(EAsyncTraceType::Single, StartLocation, EndLocation, FQuat::Identity, COLLISION_PROJECTILE,
+			FCollisionShape::MakeSphere(Radii[Idx]), QueryParams, FCollisionResponseParams::DefaultResponseParam, &SweepDelegate, ProjectileIds[Idx]);
+
+		Locations[Idx] = EndLocation;
+	}
+
+	// remove exploded entries once clients had time to show them
+	FShooterProjectileStream* Stream = GetStream();
+	if (Stream)
+	{
+		for (int32 EventIdx = Stream->Items.Num() - 1; EventIdx >= 0; EventIdx--)
+		{
+			const FShooterProjectileEvent& Event = Stream->Items[EventIdx];
+			if (Event.bExploded && TimeSeconds >= Event.RemoveTime)
+			{
+				if (World->GetNetMode() != NM_DedicatedServer)
+				{
+					OnProjectileRemoved(Event);
+				}
+
+				Stream->Items.RemoveAtSwap(EventIdx, 1, false);
+				Stream->MarkArrayDirty();
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ShooterProjectilesSimulated, ProjectileIds.Num());
+}
+
+bool UShooterProjectileManager::SpawnProjectile(AShooterWeapon_Projectile* Weapon, const FProjectileWeaponData& Config, const FVector& Origin, const FVector& ShootDir, uint16 PredictionId)
+{
+	const AShooterProjectile* ProjectileCDO = Config.ProjectileClass ? Config.ProjectileClass->GetDefaultObject<AShooterProjectile>() : NULL;
+	if (ProjectileCDO == NULL)
+	{
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	const int32 ProjectileId = NextProjectileId++;
+
+	FProjectileParams ProjectileParams;
+	ProjectileParams.Weapon = Weapon;
+	ProjectileParams.Instigator = Weapon->GetInstigator();
+	ProjectileParams.Controller = Weapon->GetInstigatorController();
+	ProjectileParams.DamageType = Config.DamageType;
+	ProjectileParams.ExplosionDamage = Config.ExplosionDamage;
+	ProjectileParams.ExplosionRadius = Config.ExplosionRadius;
+
+	IdToIndex.Add(ProjectileId, ProjectileIds.Num());
+	ProjectileIds.Add(ProjectileId);
+	Locations.Add(Origin);
+	Velocities.Add(ShootDir * ProjectileCDO->GetInitialSpeed());
+	Radii.Add(ProjectileCDO->GetCollisionRadius());
+	ExpireTimes.Add(World->GetTimeSeconds() + Config.ProjectileLife);
+	Params.Add(ProjectileParams);
+
+	FShooterProjectileEvent Event;
+	Event.ProjectileId = ProjectileId;
+	Event.ProjectileClass = Config.ProjectileClass;
+	Event.Instigator = Weapon->GetInstigator();
+	Event.PredictionId = PredictionId;
+	Event.Origin = Origin;
+	Event.Direction = ShootDir;
+	Event.SpawnTime = World->GetGameState() ? World->GetGameState()->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+
+	FShooterProjectileStream* Stream = GetStream();
+	if (Stream)
+	{
+		Stream->MarkItemDirty(Stream->Items.Add_GetRef(Event));
+		Stream->Owner->ForceNetUpdate();
+	}
+
+	// play FX locally
+	if (World->GetNetMode() != NM_DedicatedServer)
+	{
+		SpawnVisual(Event);
+	}
+
+	return true;
+}
+
+void UShooterProjectileManager::SpawnPredictedProjectile(AShooterWeapon_Projectile* Weapon, const FProjectileWeaponData& Config, const FVector& Origin, const FVector& ShootDir, uint16 PredictionId)
+{
+	FShooterProjectileEvent Event;
+	Event.ProjectileClass = Config.ProjectileClass;
+	Event.Instigator = Weapon->GetInstigator();
+	Event.PredictionId = PredictionId;
+	Event.Origin = Origin;
+	Event.Direction = ShootDir;
+	Event.SpawnTime = GetWorld()->GetGameState() ? GetWorld()->GetGameState()->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+
+	AShooterProjectile* Projectile = SpawnVisual(Event, Weapon);
+	if (Projectile)
+	{
+		Projectile->EnablePredictionCollision();
+
+		FPredictedProjectile Predicted;
+		Predicted.Instigator = Weapon->GetInstigator();
+		Predicted.Visual = Projectile;
+		Predicted.PredictionId = PredictionId;
+		Predicted.ExpireTime = GetWorld()->GetTimeSeconds() + CVar_ShooterProjectile_PredictionTimeout;
+		PredictedProjectiles.Add(Predicted);
+	}
+}
+
+void UShooterProjectileManager::RejectPredictedProjectile(APawn* Instigator, uint16 PredictionId)
+{
+	for (int32 Idx = PredictedProjectiles.Num() - 1; Idx >= 0; Idx--)
+	{
+		const FPredictedProjectile& Predicted = PredictedProjectiles[Idx];
+		if (Predicted.Instigator == Instigator && Predicted.PredictionId == PredictionId)
+		{
+			if (Predicted.Visual.IsValid())
+			{
+				Predicted.Visual->Destroy();
+			}
+
+			PredictedProjectiles.RemoveAtSwap(Idx, 1, false);
+			break;
+		}
+	}
+}
+
+AShooterProjectile* UShooterProjectileManager::ClaimPredictedVisual(const FShooterProjectileEvent& Event)
+{
+	if (Event.PredictionId == 0 || Event.Instigator == NULL || !Event.Instigator->IsLocallyControlled())
+	{
+		return NULL;
+	}
+
+	for (int32 Idx = 0; Idx < PredictedProjectiles.Num(); Idx++)
+	{
+		const FPredictedProjectile Predicted = PredictedProjectiles[Idx];
+		if (Predicted.Instigator == Event.Instigator && Predicted.PredictionId == Event.PredictionId)
+		{
+			PredictedProjectiles.RemoveAtSwap(Idx, 1, false);
+			return Predicted.Visual.Get();
+		}
+	}
+
+	return NULL;
+}
+
+void UShooterProjectileManager::ExpirePredictedProjectiles()
+{
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+	for (int32 Idx = PredictedProjectiles.Num() - 1; Idx >= 0; Idx--)
+	{
+		const FPredictedProjectile& Predicted = PredictedProjectiles[Idx];
+		if (TimeSeconds >= Predicted.ExpireTime || !Predicted.Visual.IsValid())
+		{
+			if (Predicted.Visual.IsValid())
+			{
+				Predicted.Visual->Destroy();
+			}
+
+			PredictedProjectiles.RemoveAtSwap(Idx, 1, false);
+		}
+	}
+}
+
+void UShooterProjectileManager::OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const int32* Index = IdToIndex.Find((int32)Datum.UserData);
+	if (Index == NULL)
+	{
+		// exploded or expired in the meantime
+		return;
+	}
+
+	for (const FHitResult& Hit : Datum.OutHits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			ExplodeProjectile(*Index, Hit);
+			break;
+		}
+	}
+}
+
+void UShooterProjectileManager::ExplodeProjectile(int32 Index, const FHitResult& Impact)
+{
+	// copy, damage can cause other projectiles to be removed
+	const int32 ProjectileId = ProjectileIds[Index];
+	const FProjectileParams ProjectileParams = Params[Index];
+
+	// effects and damage origin shouldn't be placed inside mesh at impact point
+	const FVector NudgedImpactLocation = Impact.ImpactPoint + Impact.ImpactNormal * 10.0f;
+
+	UShooterAreaDamage* AreaDamage = UShooterAreaDamage::Get(this);
+	if (AreaDamage && ProjectileParams.ExplosionDamage > 0 && ProjectileParams.ExplosionRadius > 0 && ProjectileParams.DamageType)
+	{
+		AreaDamage->ApplyRadialDamage(ProjectileParams.ExplosionDamage, NudgedImpactLocation, ProjectileParams.ExplosionRadius, ProjectileParams.DamageType,
+			ProjectileParams.Weapon.Get(), ProjectileParams.Controller.Get());
+	}
+
+	FShooterProjectileStream* Stream = GetStream();
+	FShooterProjectileEvent* Event = Stream ? Stream->Items.FindByPredicate([&](const FShooterProjectileEvent& Item) { return Item.ProjectileId == ProjectileId; }) : NULL;
+	if (Event)
+	{
+		Event->bExploded = true;
+		Event->ImpactPoint = Impact.ImpactPoint;
+		Event->ImpactNormal = Impact.ImpactNormal;
+		Event->RemoveTime = GetWorld()->GetTimeSeconds() + ExplodedLingerTime;
+		Stream->MarkItemDirty(*Event);
+		Stream->Owner->ForceNetUpdate();
+
+		// play FX locally
+		if (GetWorld()->GetNetMode() != NM_DedicatedServer)
+		{
+			ExplodeVisual(*Event);
+		}
+	}
+
+	const int32* CurrentIndex = IdToIndex.Find(ProjectileId);
+	if (CurrentIndex)
+	{
+		RemoveProjectile(*CurrentIndex);
+	}
+}
+
+void UShooterProjectileManager::RemoveProjectile(int32 Index)
+{
+	const int32 ProjectileId = ProjectileIds[Index];
+	IdToIndex.Remove(ProjectileId);
+
+	ProjectileIds.RemoveAtSwap(Index, 1, false);
+	Locations.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	Radii.RemoveAtSwap(Index, 1, false);
+	ExpireTimes.RemoveAtSwap(Index, 1, false);
+	Params.RemoveAtSwap(Index, 1, false);
+
+	if (ProjectileIds.IsValidIndex(Index))
+	{
+		IdToIndex.Add(ProjectileIds[Index], Index);
+	}
+
+	// expired without explosion, remove from stream right away
+	FShooterProjectileStream* Stream = GetStream();
+	if (Stream)
+	{
+		const int32 EventIdx = Stream->Items.IndexOfByPredicate([&](const FShooterProjectileEvent& Item) { return Item.ProjectileId == ProjectileId; });
+		if (EventIdx != INDEX_NONE && !Stream->Items[EventIdx].bExploded)
+		{
+			if (GetWorld()->GetNetMode() != NM_DedicatedServer)
+			{
+				OnProjectileRemoved(Stream->Items[EventIdx]);
+			}
+
+			Stream->Items.RemoveAtSwap(EventIdx, 1, false);
+			Stream->MarkArrayDirty();
+		}
+	}
+}
+
+FShooterProjectileStream* UShooterProjectileManager::GetStream() const
+{
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	return MyGameState ? &MyGameState->ProjectileStream : NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Visuals
+
+void UShooterProjectileManager::OnProjectileAdded(const FShooterProjectileEvent& Event)
+{
+	AShooterProjectile* PredictedVisual = ClaimPredictedVisual(Event);
+	if (PredictedVisual)
+	{
+		// take over our own projectile and pull it towards server's position
+		const FVector ServerLocation = GetEventLocation(Event, PredictedVisual->GetInitialSpeed());
+		PredictedVisual->BlendToServer(ServerLocation, Event.Direction, CVar_ShooterProjectile_PredictionBlendTime);
+		Visuals.Add(Event.ProjectileId, PredictedVisual);
+	}
+	else
+	{
+		SpawnVisual(Event);
+	}
+
+	// exploded before first replication
+	if (Event.bExploded)
+	{
+		ExplodeVisual(Event);
+	}
+}
+
+void UShooterProjectileManager::OnProjectileChanged(const FShooterProjectileEvent& Event)
+{
+	if (Event.bExploded)
+	{
+		ExplodeVisual(Event);
+	}
+}
+
+void UShooterProjectileManager::OnProjectileRemoved(const FShooterProjectileEvent& Event)
+{
+	TWeakObjectPtr<AShooterProjectile> Projectile;
+	if (Visuals.RemoveAndCopyValue(Event.ProjectileId, Projectile) && Projectile.IsValid() && !Event.bExploded)
+	{
+		Projectile->Destroy();
+	}
+
+	SET_DWORD_STAT(STAT_ShooterProjectilesVisual, Visuals.Num());
+}
+
+FVector UShooterProjectileManager::GetEventLocation(const FShooterProjectileEvent& Event, float Speed) const
+{
+	UWorld* World = GetWorld();
+	const float ServerTime = World->GetGameState() ? World->GetGameState()->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+	const float TimeInFlight = FMath::Max(0.0f, ServerTime - Event.SpawnTime);
+
+	return Event.Origin + Event.Direction * Speed * TimeInFlight;
+}
+
+AShooterProjectile* UShooterProjectileManager::SpawnVisual(const FShooterProjectileEvent& Event, AShooterWeapon_Projectile* Weapon)
+{
+	const AShooterProjectile* ProjectileCDO = Event.ProjectileClass ? Event.ProjectileClass->GetDefaultObject<AShooterProjectile>() : NULL;
+	if (ProjectileCDO == NULL)
+	{
+		return NULL;
+	}
+
+	FVector ShootDir = Event.Direction;
+	FTransform const SpawnTM(ShootDir.Rotation(), GetEventLocation(Event, ProjectileCDO->GetInitialSpeed()));
+
+	AShooterProjectile* Projectile = GetWorld()->SpawnActorDeferred<AShooterProjectile>(Event.ProjectileClass, SpawnTM, Weapon, Event.Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Projectile)
+	{
+		Projectile->InitVelocity(ShootDir);
+		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+
+		// predicted visuals are tracked separately until server confirms them
+		if (Event.ProjectileId != INDEX_NONE)
+		{
+			Visuals.Add(Event.ProjectileId, Projectile);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ShooterProjectilesVisual, Visuals.Num());
+	return Projectile;
+}
+
+void UShooterProjectileManager::ExplodeVisual(const FShooterProjectileEvent& Event)
+{
+	TWeakObjectPtr<AShooterProjectile> Projectile = Visuals.FindRef(Event.ProjectileId);
+	if (Projectile.IsValid())
+	{
+		FHitResult Impact;
+		Impact.bBlockingHit = true;
+		Impact.Location = Event.ImpactPoint;
+		Impact.ImpactPoint = Event.ImpactPoint;
+		Impact.Normal = Event.ImpactNormal;
+		Impact.ImpactNormal = Event.ImpactNormal;
+
+		Projectile->Explode(Impact);
+	}
+}
@@ -8,6 +8,9 @@
 #include "Online/ShooterPlayerState.h"
 #include "UI/ShooterHUD.h"
 
+float CVar_ShooterWeapon_MaxFireLag = 0.5f;
+static FAutoConsoleVariableRef CVarShooterWeaponMaxFireLag(TEXT("ShooterWeapon.MaxFireLag"), CVar_ShooterWeapon_MaxFireLag, TEXT("Max age of client fire timestamps accepted by server, and max time local refire catches up after a hitch"), ECVF_Default );
+
 AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	Mesh1P = ObjectInitializer.CreateDefaultSubobject<USkeletalMeshComponent>(this, TEXT("WeaponMesh1P"));
@@ -44,6 +47,11 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	CurrentAmmoInClip = 0;
 	BurstCounter = 0;
 	LastFireTime = 0.0f;
+	ServerFireLag = 0.0f;
+	ServerBurstStartTime = 0.0f;
+	ServerBurstShots = 0;
+	ServerBurstShotsCharged = 0;
+	ServerUnclaimedShots = 0;
 
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
@@ -56,12 +64,7 @@ void AShooterWeapon::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	if (WeaponConfig.InitialClips > 0)
-	{
-		CurrentAmmoInClip = WeaponConfig.AmmoPerClip;
-		CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
-	}
-
+	ResetForReuse();
 	DetachMeshFromPawn();
 }
 
@@ -179,6 +182,31 @@ void AShooterWeapon::OnLeaveInventory()
 	}
 }
 
+void AShooterWeapon::ResetForReuse()
+{
+	// refire, reload and equip timers of previous owner
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	StopSimulatingWeaponFire();
+
+	bWantsToFire = false;
+	bPendingReload = false;
+	bPendingEquip = false;
+	bRefiring = false;
+	CurrentState = EWeaponState::Idle;
+
+	BurstCounter = 0;
+	LastFireTime = 0.0f;
+	ServerFireLag = 0.0f;
+	ServerBurstStartTime = 0.0f;
+	ServerBurstShots = 0;
+	ServerBurstShotsCharged = 0;
+	ServerUnclaimedShots = 0;
+
+	const bool bHasInitialAmmo = (WeaponConfig.InitialClips > 0);
+	CurrentAmmoInClip = bHasInitialAmmo ? WeaponConfig.AmmoPerClip : 0;
+	CurrentAmmo = bHasInitialAmmo ? WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips : 0;
+}
+
 void AShooterWeapon::AttachMeshToPawn()
 {
 	if (MyPawn)
@@ -224,7 +252,7 @@ void AShooterWeapon::StartFire()
 {
 	if (GetLocalRole() < ROLE_Authority)
 	{
-		ServerStartFire();
+		ServerStartFire(GetFireTimestamp());
 	}
 
 	if (!bWantsToFire)
@@ -238,7 +266,7 @@ void AShooterWeapon::StopFire()
 {
 	if ((GetLocalRole() < ROLE_Authority) && MyPawn && MyPawn->IsLocallyControlled())
 	{
-		ServerStopFire();
+		ServerStopFire(GetFireTimestamp());
 	}
 
 	if (bWantsToFire)
@@ -289,23 +317,39 @@ void AShooterWeapon::StopReload()
 	}
 }
 
-bool AShooterWeapon::ServerStartFire_Validate()
+bool AShooterWeapon::ServerStartFire_Validate(float ClientTimestamp)
 {
 	return true;
 }
 
-void AShooterWeapon::ServerStartFire_Implementation()
+void AShooterWeapon::ServerStartFire_Implementation(float ClientTimestamp)
 {
+	// burst is replayed on client's timeline, so shots counted by server match shots fired by client
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	ServerFireLag = FMath::Clamp(GameTime - ClientTimestamp, 0.0f, CVar_ShooterWeapon_MaxFireLag);
+
 	StartFire();
 }
 
-bool AShooterWeapon::ServerStopFire_Validate()
+bool AShooterWeapon::ServerStopFire_Validate(float ClientTimestamp)
 {
 	return true;
 }
 
-void AShooterWeapon::ServerStopFire_Implementation()
+void AShooterWeapon::ServerStopFire_Implementation(float ClientTimestamp)
 {
+	if (CurrentState == EWeaponState::Firing && IsFiredByRemoteOwner())
+	{
+		const float GameTime = GetWorld()->GetTimeSeconds();
+		const float StopTime = FMath::Clamp(ClientTimestamp, GameTime - CVar_ShooterWeapon_MaxFireLag, GameTime);
+		SettleServerBurst(StopTime);
+		StopFire();
+
+		// stop can come later than lag sampled at start, shots settled with that lag may never have been fired by client
+		RefundServerBurst(StopTime);
+		return;
+	}
+
 	StopFire();
 }
 
@@ -316,6 +360,8 @@ bool AShooterWeapon::ServerStartReload_Validate()
 
 void AShooterWeapon::ServerStartReload_Implementation()
 {
+	// reload blocks settling, charge shots fired before it first
+	UpdateServerBurst();
 	StartReload();
 }
 
@@ -377,16 +423,22 @@ void AShooterWeapon::GiveAmmo(int AddAmount)
 	}
 }
 
-void AShooterWeapon::UseAmmo()
+void AShooterWeapon::SetReplicatedAmmo(int32 NewAmmo, int32 NewAmmoInClip)
+{
+	CurrentAmmo = NewAmmo;
+	CurrentAmmoInClip = NewAmmoInClip;
+}
+
+void AShooterWeapon::UseAmmo(int32 Count)
 {
 	if (!HasInfiniteAmmo())
 	{
-		CurrentAmmoInClip--;
+		CurrentAmmoInClip -= Count;
 	}
 
 	if (!HasInfiniteAmmo() && !HasInfiniteClip())
 	{
-		CurrentAmmo--;
+		CurrentAmmo -= Count;
 	}
 
 	AShooterAIController* BotAI = MyPawn ? Cast<AShooterAIController>(MyPawn->GetController()) : NULL;	
@@ -401,11 +453,11 @@ void AShooterWeapon::UseAmmo()
 		switch (GetAmmoType())
 		{
 			case EAmmoType::ERocket:
-				PlayerState->AddRocketsFired(1);
+				PlayerState->AddRocketsFired(Count);
 				break;
 			case EAmmoType::EBullet:
 			default:
-				PlayerState->AddBulletsFired(1);
+				PlayerState->AddBulletsFired(Count);
 				break;			
 		}
 	}
@@ -413,21 +465,22 @@ void AShooterWeapon::UseAmmo()
 
 void AShooterWeapon::HandleReFiring()
 {
-	// Update TimerIntervalAdjustment
-	UWorld* MyWorld = GetWorld();
-
-	float SlackTimeThisFrame = FMath::Max(0.0f, (MyWorld->TimeSeconds - LastFireTime) - WeaponConfig.TimeBetweenShots);
-
-	if (bAllowAutomaticWeaponCatchup)
+	// timer can't sample faster than frame rate, fire every shot that became due since last one
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	do
 	{
-		TimerIntervalAdjustment -= SlackTimeThisFrame;
+		HandleFiring();
 	}
-
-	HandleFiring();
+	while (bRefiring && bAllowAutomaticWeaponCatchup && LastFireTime + WeaponConfig.TimeBetweenShots <= GameTime);
 }
 
 void AShooterWeapon::HandleFiring()
 {
+	// refire keeps fixed interval from previous shot, so fire rate doesn't depend on frame rate
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	const float ShotTime = (bRefiring && bAllowAutomaticWeaponCatchup) ?
+		FMath::Max(LastFireTime + WeaponConfig.TimeBetweenShots, GameTime - CVar_ShooterWeapon_MaxFireLag) : GameTime;
+
 	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
 		if (GetNetMode() != NM_DedicatedServer)
@@ -475,12 +528,6 @@ void AShooterWeapon::HandleFiring()
 
 	if (MyPawn && MyPawn->IsLocallyControlled())
 	{
-		// local client will notify server
-		if (GetLocalRole() < ROLE_Authority)
-		{
-			ServerHandleFiring();
-		}
-
 		// reload after firing last round
 		if (CurrentAmmoInClip <= 0 && CanReload())
 		{
@@ -491,35 +538,138 @@ void AShooterWeapon::HandleFiring()
 		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleReFiring, FMath::Max<float>(WeaponConfig.TimeBetweenShots + TimerIntervalAdjustment, SMALL_NUMBER), false);
-			TimerIntervalAdjustment = 0.f;
+			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleReFiring, FMath::Max<float>(ShotTime + WeaponConfig.TimeBetweenShots - GameTime, SMALL_NUMBER), false);
 		}
 	}
 
-	LastFireTime = GetWorld()->GetTimeSeconds();
+	LastFireTime = ShotTime;
 }
 
-bool AShooterWeapon::ServerHandleFiring_Validate()
+void AShooterWeapon::HandleServerBurst()
 {
-	return true;
+	const float GameTime = GetWorld()->GetTimeSeconds();
+	SettleServerBurst(GameTime - ServerFireLag);
+
+	// shots in between are settled in bulk when needed (UpdateServerBurst), single timer only catches clip running dry
+	// semi-auto weapons fire single shot per burst, infinite clip never runs dry
+	const bool bFiniteClip = !HasInfiniteClip() && !HasInfiniteAmmo();
+	if (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f && bFiniteClip && CurrentAmmoInClip > 0)
+	{
+		const float LastShotTime = ServerBurstStartTime + (ServerBurstShots + CurrentAmmoInClip - 1) * WeaponConfig.TimeBetweenShots + ServerFireLag;
+		GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleServerBurst, FMath::Max<float>(LastShotTime - GameTime, SMALL_NUMBER), false);
+	}
+}
+
+void AShooterWeapon::UpdateServerBurst()
+{
+	if (CurrentState == EWeaponState::Firing && IsFiredByRemoteOwner())
+	{
+		SettleServerBurst(GetWorld()->GetTimeSeconds() - ServerFireLag);
+	}
 }
 
-void AShooterWeapon::ServerHandleFiring_Implementation()
+void AShooterWeapon::SettleServerBurst(float UpToTime)
 {
-	const bool bShouldUpdateAmmo = (CurrentAmmoInClip > 0 && CanFire());
+	const int32 ShotsDue = GetServerBurstShotsDue(UpToTime);
+	int32 NewShots = ShotsDue - ServerBurstShots;
+	if (NewShots <= 0 || !CanFire())
+	{
+		return;
+	}
 
-	HandleFiring();
+	// shots client couldn't fire with empty clip are skipped, not delayed
+	ServerBurstShots = ShotsDue;
+	if (!HasInfiniteClip() && !HasInfiniteAmmo())
+	{
+		NewShots = FMath::Min(NewShots, FMath::Max(CurrentAmmoInClip, 0));
+	}
 
-	if (bShouldUpdateAmmo)
+	if (NewShots > 0)
 	{
-		// update ammo
-		UseAmmo();
+		UseAmmo(NewShots);
+		ServerBurstShotsCharged += NewShots;
+		ServerUnclaimedShots = FMath::Min(ServerUnclaimedShots + NewShots, WeaponConfig.AmmoPerClip);
 
 		// update firing FX on remote clients
-		BurstCounter++;
+		BurstCounter += NewShots;
+		LastFireTime = ServerBurstStartTime + (ShotsDue - 1) * WeaponConfig.TimeBetweenShots;
+
+		if (GetNetMode() != NM_DedicatedServer)
+		{
+			SimulateWeaponFire();
+		}
 	}
 }
 
+int32 AShooterWeapon::GetServerBurstShotsDue(float UpToTime) const
+{
+	if (UpToTime < ServerBurstStartTime)
+	{
+		return 0;
+	}
+
+	return (WeaponConfig.TimeBetweenShots > 0.0f) ? FMath::FloorToInt((UpToTime - ServerBurstStartTime) / WeaponConfig.TimeBetweenShots) + 1 : 1;
+}
+
+void AShooterWeapon::RefundServerBurst(float StopTime)
+{
+	// shots are charged in order until clip runs out, so everything charged past stop shot is extra
+	const int32 ShotsFired = GetServerBurstShotsDue(StopTime);
+	const int32 ExtraShots = ServerBurstShotsCharged - ShotsFired;
+	if (ExtraShots <= 0)
+	{
+		return;
+	}
+
+	if (!HasInfiniteAmmo())
+	{
+		CurrentAmmoInClip += ExtraShots;
+	}
+
+	if (!HasInfiniteAmmo() && !HasInfiniteClip())
+	{
+		CurrentAmmo += ExtraShots;
+	}
+
+	ServerBurstShots = ShotsFired;
+	ServerBurstShotsCharged = ShotsFired;
+	ServerUnclaimedShots = FMath::Max(ServerUnclaimedShots - ExtraShots, -WeaponConfig.AmmoPerClip);
+	if (ShotsFired > 0)
+	{
+		LastFireTime = ServerBurstStartTime + (ShotsFired - 1) * WeaponConfig.TimeBetweenShots;
+	}
+}
+
+bool AShooterWeapon::ClaimServerShot()
+{
+	if (!IsFiredByRemoteOwner())
+	{
+		return CanFire();
+	}
+
+	UpdateServerBurst();
+
+	// last shot of clip can be settled before its request arrives, when server timeline already waits for reload
+	if (ServerUnclaimedShots <= 0 && !CanFire())
+	{
+		return false;
+	}
+
+	ServerUnclaimedShots = FMath::Max(ServerUnclaimedShots - 1, -WeaponConfig.AmmoPerClip);
+	return true;
+}
+
+bool AShooterWeapon::IsFiredByRemoteOwner() const
+{
+	return GetLocalRole() == ROLE_Authority && MyPawn && !MyPawn->IsLocallyControlled();
+}
+
+float AShooterWeapon::GetFireTimestamp() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
 void AShooterWeapon::ReloadWeapon()
 {
 	int32 ClipDelta = FMath::Min(WeaponConfig.AmmoPerClip - CurrentAmmoInClip, CurrentAmmo - CurrentAmmoInClip);
@@ -591,7 +741,16 @@ void AShooterWeapon::OnBurstStarted()
 {
 	// start firing, can be delayed to satisfy TimeBetweenShots
 	const float GameTime = GetWorld()->GetTimeSeconds();
-	if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
+	if (IsFiredByRemoteOwner())
+	{
+		// owning client fires locally, server only keeps ammo and fire FX in sync with its timeline
+		const float ClientTime = GameTime - ServerFireLag;
+		ServerBurstStartTime = (LastFireTime > 0) ? FMath::Max(ClientTime, LastFireTime + WeaponConfig.TimeBetweenShots) : ClientTime;
+		ServerBurstShots = 0;
+		ServerBurstShotsCharged = 0;
+		HandleServerBurst();
+	}
+	else if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
 		LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
 	{
 		GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
@@ -604,6 +763,9 @@ void AShooterWeapon::OnBurstStarted()
 
 void AShooterWeapon::OnBurstFinished()
 {
+	// charge shots fired since last update, burst can end without stop request (unequip)
+	UpdateServerBurst();
+
 	// stop firing FX on remote clients
 	BurstCounter = 0;
 
@@ -615,9 +777,6 @@ void AShooterWeapon::OnBurstFinished()
 	
 	GetWorldTimerManager().ClearTimer(TimerHandle_HandleFiring);
 	bRefiring = false;
-
-	// reset firing interval adjustment
-	TimerIntervalAdjustment = 0.0f;
 }
 
 
@@ -916,9 +1075,6 @@ void AShooterWeapon::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & O
 
 	DOREPLIFETIME( AShooterWeapon, MyPawn );
 
-	DOREPLIFETIME_CONDITION( AShooterWeapon, CurrentAmmo,		COND_OwnerOnly );
-	DOREPLIFETIME_CONDITION( AShooterWeapon, CurrentAmmoInClip, COND_OwnerOnly );
-
 	DOREPLIFETIME_CONDITION( AShooterWeapon, BurstCounter,		COND_SkipOwner );
 	DOREPLIFETIME_CONDITION( AShooterWeapon, bPendingReload,	COND_SkipOwner );
 }
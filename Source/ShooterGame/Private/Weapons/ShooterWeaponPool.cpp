@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeaponPool.h"
+#include "Weapons/ShooterWeapon.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Pool Acquire"), STAT_ShooterWeaponPoolAcquire, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Weapons Spawned"), STAT_ShooterWeaponsSpawned, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Weapons Reused"), STAT_ShooterWeaponsReused, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Weapons"), STAT_ShooterPooledWeapons, STATGROUP_ShooterGame);
+
+FOnShooterWeaponPooled UShooterWeaponPool::NotifyWeaponPooled;
+FOnShooterWeaponUnpooled UShooterWeaponPool::NotifyWeaponUnpooled;
+
+UShooterWeaponPool* UShooterWeaponPool::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : NULL;
+	return World ? World->GetSubsystem<UShooterWeaponPool>() : NULL;
+}
+
+void UShooterWeaponPool::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ShooterPooledWeapons, FreeWeapons.Num());
+	FreeWeapons.Empty();
+
+	Super::Deinitialize();
+}
+
+AShooterWeapon* UShooterWeaponPool::AcquireWeapon(TSubclassOf<AShooterWeapon> WeaponClass)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterWeaponPoolAcquire);
+
+	if (WeaponClass == NULL)
+	{
+		return NULL;
+	}
+
+	for (int32 WeaponIdx = FreeWeapons.Num() - 1; WeaponIdx >= 0; WeaponIdx--)
+	{
+		AShooterWeapon* Weapon = FreeWeapons[WeaponIdx].Get();
+		if (Weapon == NULL || Weapon->IsPendingKill())
+		{
+			FreeWeapons.RemoveAtSwap(WeaponIdx);
+			DEC_DWORD_STAT(STAT_ShooterPooledWeapons);
+			continue;
+		}
+
+		if (Weapon->GetClass() == WeaponClass)
+		{
+			FreeWeapons.RemoveAtSwap(WeaponIdx);
+			DEC_DWORD_STAT(STAT_ShooterPooledWeapons);
+			INC_DWORD_STAT(STAT_ShooterWeaponsReused);
+
+			// wake up channel, client keeps actor from before it went dormant
+			NotifyWeaponUnpooled.Broadcast(Weapon);
+			Weapon->SetNetDormancy(DORM_Awake);
+			Weapon->SetActorTickEnabled(true);
+			Weapon->ResetForReuse();
+			return Weapon;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_ShooterWeaponsSpawned);
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<AShooterWeapon>(WeaponClass, SpawnInfo);
+}
+
+void UShooterWeaponPool::ReleaseWeapon(AShooterWeapon* Weapon)
+{
+	if (Weapon == NULL || Weapon->IsPendingKill())
+	{
+		return;
+	}
+
+	if (FreeWeapons.Contains(Weapon))
+	{
+		return;
+	}
+
+	// owner change still replicates, then channel closes as dormant instead of destroying actor on clients
+	// weapon is no longer a dependent of any pawn, replication graph keeps it routed while in pool
+	Weapon->SetActorTickEnabled(false);
+	Weapon->SetNetDormancy(DORM_DormantAll);
+	NotifyWeaponPooled.Broadcast(Weapon);
+
+	FreeWeapons.Add(Weapon);
+	INC_DWORD_STAT(STAT_ShooterPooledWeapons);
+}
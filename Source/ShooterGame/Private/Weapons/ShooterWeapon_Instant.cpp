@@ -4,6 +4,7 @@
 #include "Weapons/ShooterWeapon_Instant.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Effects/ShooterImpactEffect.h"
+#include "Effects/ShooterEffectBudget.h"
 
 AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -117,9 +118,7 @@ void AShooterWeapon_Instant::ServerNotifyMiss_Implementation(FVector_NetQuantize
 	const FVector Origin = GetMuzzleLocation();
 
 	// play FX on remote clients
-	HitNotify.Origin = Origin;
-	HitNotify.RandomSeed = RandomSeed;
-	HitNotify.ReticleSpread = ReticleSpread;
+	SetHitNotify(FHitResult(), Origin, RandomSeed, ReticleSpread);
 
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
@@ -169,9 +168,7 @@ void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impac
 	// play FX on remote clients
 	if (GetLocalRole() == ROLE_Authority)
 	{
-		HitNotify.Origin = Origin;
-		HitNotify.RandomSeed = RandomSeed;
-		HitNotify.ReticleSpread = ReticleSpread;
+		SetHitNotify(Impact, Origin, RandomSeed, ReticleSpread);
 	}
 
 	// play FX locally
@@ -181,7 +178,7 @@ void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impac
 		const FVector EndPoint = Impact.GetActor() ? Impact.ImpactPoint : EndTrace;
 
 		SpawnTrailEffect(EndPoint);
-		SpawnImpactEffects(Impact);
+		SpawnImpactEffects(Impact, UPhysicalMaterial::DetermineSurfaceType(Impact.PhysMaterial.Get()));
 	}
 }
 
@@ -240,51 +237,69 @@ float AShooterWeapon_Instant::GetCurrentSpread() const
 
 void AShooterWeapon_Instant::OnRep_HitNotify()
 {
-	SimulateInstantHit(HitNotify.Origin, HitNotify.RandomSeed, HitNotify.ReticleSpread);
+	SimulateInstantHit(HitNotify);
 }
 
-void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32 RandomSeed, float ReticleSpread)
+void AShooterWeapon_Instant::SetHitNotify(const FHitResult& Impact, const FVector& Origin, int32 RandomSeed, float ReticleSpread)
 {
-	FRandomStream WeaponRandomStream(RandomSeed);
-	const float ConeHalfAngle = FMath::DegreesToRadians(ReticleSpread * 0.5f);
-
-	const FVector StartTrace = ShotOrigin;
-	const FVector AimDir = GetAdjustedAim();
-	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
+	HitNotify.Origin = Origin;
+	HitNotify.RandomSeed = RandomSeed;
+	HitNotify.ReticleSpread = ReticleSpread;
+	HitNotify.bHasImpact = Impact.bBlockingHit;
 
-	FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 	if (Impact.bBlockingHit)
 	{
-		SpawnImpactEffects(Impact);
+		HitNotify.ImpactPoint = Impact.ImpactPoint;
+		HitNotify.ImpactNormal = Impact.ImpactNormal;
+		HitNotify.SurfaceType = UPhysicalMaterial::DetermineSurfaceType(Impact.PhysMaterial.Get());
+	}
+}
+
+void AShooterWeapon_Instant::SimulateInstantHit(const FInstantHitInfo& HitInfo)
+{
+	// server already resolved the hit, just rebuild it for effects
+	if (HitInfo.bHasImpact)
+	{
+		FHitResult Impact;
+		Impact.bBlockingHit = true;
+		Impact.Location = HitInfo.ImpactPoint;
+		Impact.ImpactPoint = HitInfo.ImpactPoint;
+		Impact.Normal = HitInfo.ImpactNormal;
+		Impact.ImpactNormal = HitInfo.ImpactNormal;
+
+		SpawnImpactEffects(Impact, (EPhysicalSurface)HitInfo.SurfaceType);
 		SpawnTrailEffect(Impact.ImpactPoint);
 	}
 	else
 	{
+		FRandomStream WeaponRandomStream(HitInfo.RandomSeed);
+		const float ConeHalfAngle = FMath::DegreesToRadians(HitInfo.ReticleSpread * 0.5f);
+
+		const FVector AimDir = GetAdjustedAim();
+		const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
+		const FVector EndTrace = HitInfo.Origin + ShootDir * InstantConfig.WeaponRange;
+
 		SpawnTrailEffect(EndTrace);
 	}
 }
 
-void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
+void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact, EPhysicalSurface SurfaceType)
 {
 	if (ImpactTemplate && Impact.bBlockingHit)
 	{
-		FHitResult UseImpact = Impact;
-
-		// trace again to find component lost during replication
-		if (!Impact.Component.IsValid())
+		// near-duplicate of recent impact (e.g. shotgun pellets, fast refire), skip effect actor
+		UShooterEffectBudget* EffectBudget = UShooterEffectBudget::Get(this);
+		if (EffectBudget && !EffectBudget->ShouldSpawnImpact(Impact.ImpactPoint))
 		{
-			const FVector StartTrace = Impact.ImpactPoint + Impact.ImpactNormal * 10.0f;
-			const FVector EndTrace = Impact.ImpactPoint - Impact.ImpactNormal * 10.0f;
-			FHitResult Hit = WeaponTrace(StartTrace, EndTrace);
-			UseImpact = Hit;
+			return;
 		}
 
 		FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint);
 		AShooterImpactEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(ImpactTemplate, SpawnTransform);
 		if (EffectActor)
 		{
-			EffectActor->SurfaceHit = UseImpact;
+			EffectActor->SurfaceHit = Impact;
+			EffectActor->SurfaceType = SurfaceType;
 			UGameplayStatics::FinishSpawningActor(EffectActor, SpawnTransform);
 		}
 	}
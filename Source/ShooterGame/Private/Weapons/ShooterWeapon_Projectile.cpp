@@ -2,10 +2,11 @@
 
 #include "ShooterGame.h"
 #include "Weapons/ShooterWeapon_Projectile.h"
-#include "Weapons/ShooterProjectile.h"
+#include "Weapons/ShooterProjectileManager.h"
 
 AShooterWeapon_Projectile::AShooterWeapon_Projectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	NextPredictionId = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -61,25 +62,43 @@ void AShooterWeapon_Projectile::FireWeapon()
 		}
 	}
 
-	ServerFireProjectile(Origin, ShootDir);
+	// show projectile right away on remote client, server one will take it over when it replicates
+	uint16 PredictionId = 0;
+	UShooterProjectileManager* ProjectileManager = UShooterProjectileManager::Get(this);
+	if (ProjectileManager && GetNetMode() == NM_Client)
+	{
+		// 0 is reserved for not predicted projectiles
+		NextPredictionId = FMath::Max<uint16>(NextPredictionId + 1, 1);
+		PredictionId = NextPredictionId;
+
+		ProjectileManager->SpawnPredictedProjectile(this, ProjectileConfig, Origin, ShootDir, PredictionId);
+	}
+
+	ServerFireProjectile(Origin, ShootDir, PredictionId);
 }
 
-bool AShooterWeapon_Projectile::ServerFireProjectile_Validate(FVector Origin, FVector_NetQuantizeNormal ShootDir)
+bool AShooterWeapon_Projectile::ServerFireProjectile_Validate(FVector Origin, FVector_NetQuantizeNormal ShootDir, uint16 PredictionId)
 {
 	return true;
 }
 
-void AShooterWeapon_Projectile::ServerFireProjectile_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir)
+void AShooterWeapon_Projectile::ServerFireProjectile_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir, uint16 PredictionId)
 {
-	FTransform SpawnTM(ShootDir.Rotation(), Origin);
-	AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ProjectileConfig.ProjectileClass, SpawnTM));
-	if (Projectile)
+	UShooterProjectileManager* ProjectileManager = UShooterProjectileManager::Get(this);
+	const bool bSpawned = ClaimServerShot() && ProjectileManager && ProjectileManager->SpawnProjectile(this, ProjectileConfig, Origin, ShootDir, PredictionId);
+
+	if (!bSpawned && PredictionId != 0)
 	{
-		Projectile->SetInstigator(GetInstigator());
-		Projectile->SetOwner(this);
-		Projectile->InitVelocity(ShootDir);
+		ClientRejectProjectile(PredictionId);
+	}
+}
 
-		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+void AShooterWeapon_Projectile::ClientRejectProjectile_Implementation(uint16 PredictionId)
+{
+	UShooterProjectileManager* ProjectileManager = UShooterProjectileManager::Get(this);
+	if (ProjectileManager)
+	{
+		ProjectileManager->RejectPredictedProjectile(GetInstigator(), PredictionId);
 	}
 }
 
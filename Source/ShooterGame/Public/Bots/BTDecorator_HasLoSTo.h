@@ -17,7 +17,4 @@ protected:
 	
 	UPROPERTY(EditAnywhere, Category = Condition)
  	struct FBlackboardKeySelector EnemyKey;
-
-private:
-	bool LOSTrace(AActor* InActor, AActor* InEnemyActor, const FVector& EndLocation) const;	
 };
@@ -50,7 +50,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Behavior)
 	bool FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEnemy);
 		
-	bool HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const;
+	/** last known weapon line of sight to enemy, see GetCachedLOS */
+	bool HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy);
+
+	/**
+	* Last known line of sight from eyes, requests async trace when result is missing or stale.
+	* Traces of all bots are processed together with the world's async traces, results are available next frame.
+	*
+	* @param InEnemyActor		Target actor, NULL when testing location only.
+	* @param TargetLocation		Where to trace.
+	* @param bAnyEnemy			Blocking hit on any enemy character counts as line of sight.
+	*/
+	bool GetCachedLOS(AActor* InEnemyActor, const FVector& TargetLocation, const bool bAnyEnemy);
 
 	// Begin AAIController interface
 	/** Update direction AI is looking based on FocalPoint */
@@ -67,6 +78,45 @@ protected:
 	/** Handle for efficient management of Respawn timer */
 	FTimerHandle TimerHandle_Respawn;
 
+	/** line of sight result for single target */
+	struct FLOSCacheEntry
+	{
+		/** location traced to */
+		FVector TargetLocation;
+
+		/** game time of result, negative if none yet */
+		float ResultTime;
+
+		/** trace in flight */
+		FTraceHandle PendingTrace;
+
+		/** trace hit target */
+		uint8 bHasLOS : 1;
+
+		/** trace hit target or any enemy character */
+		uint8 bHasLOSToAnyEnemy : 1;
+
+		FLOSCacheEntry()
+			: TargetLocation(FVector::ZeroVector)
+			, ResultTime(-1.0f)
+			, bHasLOS(false)
+			, bHasLOSToAnyEnemy(false)
+		{
+		}
+	};
+
+	/** line of sight results by target actor, null key for location target */
+	TMap<TWeakObjectPtr<AActor>, FLOSCacheEntry> LOSCache;
+
+	/** bound to OnLOSTraceDone */
+	FTraceDelegate LOSTraceDelegate;
+
+	/** store result of async line of sight trace */
+	void OnLOSTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+
+	/** remove results of destroyed and long unused targets */
+	void PruneLOSCache();
+
 public:
 	/** Returns BlackboardComp subobject **/
 	FORCEINLINE UBlackboardComponent* GetBlackboardComp() const { return BlackboardComp; }
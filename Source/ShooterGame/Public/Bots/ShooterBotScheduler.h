@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterBotScheduler.generated.h"
+
+class AShooterAIController;
+
+//
+// Per world scheduler of bot decisions - server only
+// Behavior trees of registered bots don't tick on their own, scheduler ticks the most overdue ones each frame
+// until its time budget is used up. Bots close to human players want updates often, distant ones rarely.
+//
+UCLASS()
+class UShooterBotScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get scheduler of world owning given object */
+	static UShooterBotScheduler* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+	/** take over behavior tree updates of bot */
+	void RegisterBot(AShooterAIController* Bot);
+
+	/** stop updating bot */
+	void UnregisterBot(AShooterAIController* Bot);
+
+protected:
+
+	/** scheduling state of single bot */
+	struct FScheduledBot
+	{
+		TWeakObjectPtr<AShooterAIController> Controller;
+
+		/** game time of last decision update */
+		float LastUpdateTime;
+
+		/** wanted time between updates, based on distance to human players */
+		float UpdateInterval;
+
+		/** how overdue the update is, 1 = due now */
+		float Priority;
+	};
+
+	/** all registered bots */
+	TArray<FScheduledBot> Bots;
+
+	/** get wanted update interval of bot, based on distance to closest human */
+	float GetUpdateInterval(const AShooterAIController* Bot, const TArray<FVector>& HumanLocations) const;
+};
@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "NavAreas/NavArea.h"
+#include "ShooterNavAreas.generated.h"
+
+/** area of baked traversal links, bots use movement ability when path segment starts in it */
+UCLASS(Abstract)
+class UShooterNavArea_Traversal : public UNavArea
+{
+	GENERATED_UCLASS_BODY()
+};
+
+/** jetpack ascent to higher ledge */
+UCLASS()
+class UShooterNavArea_Jetpack : public UShooterNavArea_Traversal
+{
+	GENERATED_UCLASS_BODY()
+};
+
+/** wall run along "Wall" tagged actor */
+UCLASS()
+class UShooterNavArea_WallRun : public UShooterNavArea_Traversal
+{
+	GENERATED_UCLASS_BODY()
+};
+
+/** teleport hop */
+UCLASS()
+class UShooterNavArea_Teleport : public UShooterNavArea_Traversal
+{
+	GENERATED_UCLASS_BODY()
+};
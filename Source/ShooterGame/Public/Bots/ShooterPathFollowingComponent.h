@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Navigation/PathFollowingComponent.h"
+#include "ShooterTraversalLinks.h"
+#include "ShooterPathFollowingComponent.generated.h"
+
+class UShooterCharacterMovement;
+
+// Path following of bots, uses movement abilities on segments crossing baked traversal links (see AShooterTraversalLinks)
+UCLASS()
+class UShooterPathFollowingComponent : public UPathFollowingComponent
+{
+	GENERATED_UCLASS_BODY()
+
+protected:
+
+	// Begin UPathFollowingComponent interface
+	virtual void SetMoveSegment(int32 SegmentStartIndex) override;
+	virtual void FollowPathSegment(float DeltaTime) override;
+	virtual void OnPathFinished(const FPathFollowingResult& Result) override;
+	// End UPathFollowingComponent interface
+
+	/** current segment crosses traversal link */
+	bool bIsTraversing;
+
+	/** ability used on current segment */
+	EShooterTraversalType TraversalType;
+
+	/** where link ends */
+	FVector TraversalEnd;
+
+	/** get movement component of controlled character */
+	UShooterCharacterMovement* GetShooterMovement() const;
+
+	/** start using ability for current segment */
+	void StartTraversal(EShooterTraversalType Type, const FVector& Start, const FVector& End);
+
+	/** release ability input */
+	void StopTraversal();
+};
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterTacticalPoints.generated.h"
+
+//
+// Per world set of tactical positions for bots - server only
+// Points are sampled from navmesh at match start (or first use), each knows how much cover it has. Reachability is tested once per point
+// and cached. Scored candidates around an enemy are shared by all bots attacking it, and bots spread over them.
+//
+UCLASS()
+class UShooterTacticalPoints : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterTacticalPoints();
+
+	/** get point set of world owning given object */
+	static UShooterTacticalPoints* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/**
+	* Find best reachable point to attack enemy from.
+	*
+	* @param Enemy			Target, candidates around it are cached and shared.
+	* @param Bot			Pawn looking for point, spread from other bots attacking same enemy.
+	* @param OutLocation	Found point.
+	* @return false if there is no usable point near enemy.
+	*/
+	bool FindPointNearEnemy(const AActor* Enemy, const APawn* Bot, FVector& OutLocation);
+
+	/** sample navmesh and test cover of points, done at match start so first bot query doesn't hitch */
+	void BuildPoints();
+
+	/** free point claimed by bot, for any enemy */
+	void ReleaseClaims(const APawn* Bot);
+
+	/** number of navmesh queries done so far */
+	int32 GetNumNavQueries() const { return NumNavQueries; }
+
+protected:
+
+	/** single tactical position */
+	struct FTacticalPoint
+	{
+		FVector Location;
+
+		/** directions blocked for weapons, bit per 45 degrees */
+		uint8 CoverMask;
+
+		/** number of bits in CoverMask */
+		uint8 NumCover;
+
+		/** cached path test result: -1 unknown, 0 unreachable, 1 reachable */
+		int8 Reachable;
+	};
+
+	/** candidates around single enemy */
+	struct FEnemyCandidates
+	{
+		/** enemy location and game time when scored */
+		FVector EnemyLocation;
+		float ScoreTime;
+
+		/** point index and score not depending on bot */
+		TArray<TPair<float, int32>> Scored;
+
+		/** points taken by bots */
+		TMap<TWeakObjectPtr<const APawn>, int32> Claims;
+	};
+
+	/** all points */
+	TArray<FTacticalPoint> Points;
+
+	/** point indices by cell */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** cell size points were built with */
+	float CellSize;
+
+	/** points were sampled */
+	bool bBuilt;
+
+	/** path tests are done to this location */
+	FVector ReachabilityOrigin;
+
+	/** cached candidates by enemy */
+	TMap<TWeakObjectPtr<const AActor>, FEnemyCandidates> EnemyCandidates;
+
+	/** navmesh queries counter */
+	int32 NumNavQueries;
+
+	/** score points around enemy, ignoring bots */
+	void ScoreCandidates(const AActor* Enemy, FEnemyCandidates& Candidates);
+
+	/** check and cache if point can be reached */
+	bool IsReachable(int32 PointIdx);
+
+	/** get cell containing location */
+	FIntPoint GetCell(const FVector& Location) const;
+};
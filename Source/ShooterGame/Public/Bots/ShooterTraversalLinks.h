@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "AI/Navigation/NavLinkDefinition.h"
+#include "AI/Navigation/NavLinkHostInterface.h"
+#include "AI/Navigation/NavRelevantInterface.h"
+#include "ShooterTraversalLinks.generated.h"
+
+UENUM()
+enum class EShooterTraversalType : uint8
+{
+	Jetpack,
+	WallRun,
+	Teleport,
+};
+
+/** single baked link, in actor space */
+USTRUCT()
+struct FShooterTraversalLink
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category=Traversal)
+	FVector Start;
+
+	UPROPERTY(VisibleAnywhere, Category=Traversal)
+	FVector End;
+
+	UPROPERTY(VisibleAnywhere, Category=Traversal)
+	EShooterTraversalType Type;
+
+	FShooterTraversalLink()
+		: Start(FVector::ZeroVector)
+		, End(FVector::ZeroVector)
+		, Type(EShooterTraversalType::Jetpack)
+	{
+	}
+};
+
+//
+// Navigation links for bot movement abilities, one actor placed per map
+// Links are baked in editor (BakeLinks button) from the navmesh and saved with the map:
+// jetpack ascents to ledges, wall runs along "Wall" tagged actors and teleport hops.
+// Each link type has its own nav area, so path following knows which ability to use.
+//
+UCLASS(NotBlueprintable)
+class AShooterTraversalLinks : public AActor, public INavLinkHostInterface, public INavRelevantInterface
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	// Begin INavLinkHostInterface interface
+	virtual bool GetNavigationLinksClasses(TArray<TSubclassOf<UNavLinkDefinition>>& OutClasses) const override;
+	virtual bool GetNavigationLinksArray(TArray<FNavigationLink>& OutLink, TArray<FNavigationSegmentLink>& OutSegments) const override;
+	// End INavLinkHostInterface interface
+
+	// Begin INavRelevantInterface interface
+	virtual void GetNavigationData(FNavigationRelevantData& Data) const override;
+	virtual FBox GetNavigationBounds() const override;
+	virtual bool IsNavigationRelevant() const override;
+	// End INavRelevantInterface interface
+
+	/** get traversal type of nav area, false if it's not area of traversal link */
+	static bool GetTraversalType(const UClass* AreaClass, EShooterTraversalType& OutType);
+
+#if WITH_EDITOR
+	/** rebuild all links from current navmesh */
+	UFUNCTION(CallInEditor, Category=Traversal)
+	void BakeLinks();
+#endif
+
+protected:
+
+	/** baked links */
+	UPROPERTY(VisibleAnywhere, Category=Traversal)
+	TArray<FShooterTraversalLink> Links;
+
+	/** navmesh samples closer than this are merged */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float SampleSpacing;
+
+	/** height range of jetpack ascents */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float MinJetpackHeight;
+
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float MaxJetpackHeight;
+
+	/** max horizontal distance of jetpack ascent */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float MaxJetpackDistance;
+
+	/** should match TeleportDistance of bot's movement component */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float TeleportDistance;
+
+	/** teleport hops are tested only from navmesh samples on this grid */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float TeleportSpacing;
+
+	/** max links starting at single navmesh sample, per type */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	int32 MaxLinksPerSample;
+
+	/** link is added only if walking path is this many times longer than link, or doesn't exist */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float MinDetourRatio;
+
+	/** size of capsule used for clearance tests */
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float AgentRadius;
+
+	UPROPERTY(EditAnywhere, Category=Bake)
+	float AgentHalfHeight;
+
+	/** links converted for navigation system */
+	TArray<FNavigationLink> NavLinks;
+
+	/** bounds of all links, in world space */
+	FBox LinksBounds;
+
+	/** rebuild NavLinks and LinksBounds from Links */
+	void UpdateNavLinks();
+
+	virtual void PostRegisterAllComponents() override;
+
+#if WITH_EDITOR
+	/** true if link saves long walk, or there is no walking path at all */
+	bool IsWorthLink(const FVector& Start, const FVector& End) const;
+
+	/** add link in world space */
+	void AddLink(const FVector& Start, const FVector& End, EShooterTraversalType Type);
+#endif
+};
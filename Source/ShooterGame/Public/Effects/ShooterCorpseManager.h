@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterCorpseManager.generated.h"
+
+class AShooterCharacter;
+class UPoseableMeshComponent;
+
+//
+// Per world manager of dead characters - NOT used on dedicated servers
+// Ragdolls are frozen into a posed copy of their mesh once settled or far from local viewers, and the dead pawn
+// is destroyed right away. Number of corpses is capped (oldest one sinks out quickly), posed meshes are recycled.
+//
+UCLASS()
+class UShooterCorpseManager : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterCorpseManager();
+
+	/** get manager of world owning given object */
+	static UShooterCorpseManager* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+	/** take over lifetime of character that just started ragdoll, false if it has to manage it by itself */
+	bool RegisterCorpse(AShooterCharacter* Character);
+
+protected:
+
+	/** single dead character, simulated ragdoll first and posed mesh once frozen */
+	struct FCorpse
+	{
+		TWeakObjectPtr<AShooterCharacter> Character;
+		UPoseableMeshComponent* PosedMesh;
+
+		/** game time of registration */
+		float DeathTime;
+
+		/** game time fade started, negative when not fading */
+		float FadeStartTime;
+		float FadeDuration;
+
+		/** location of posed mesh when fade started */
+		FVector FadeStartLocation;
+	};
+
+	/** all corpses, oldest first */
+	TArray<FCorpse> Corpses;
+
+	/** all posed meshes created by manager */
+	UPROPERTY(Transient)
+	TArray<UPoseableMeshComponent*> PosedMeshes;
+
+	/** posed meshes ready for reuse */
+	TArray<UPoseableMeshComponent*> FreePosedMeshes;
+
+	/** game time of last freeze and cap checks */
+	float LastUpdateTime;
+
+	/** copy ragdoll pose to posed mesh and destroy dead character, false if character can't be destroyed yet */
+	bool FreezeCorpse(FCorpse& Corpse);
+
+	/** start sinking corpse out of view */
+	void StartFade(FCorpse& Corpse, float Duration);
+
+	/** check if any local player camera is within distance */
+	bool IsNearLocalViewer(const FVector& Location, float MaxDistance) const;
+};
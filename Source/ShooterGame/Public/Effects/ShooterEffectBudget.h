@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterEffectBudget.generated.h"
+
+class UDecalComponent;
+class UMaterialInterface;
+class UParticleSystem;
+class UParticleSystemComponent;
+class USoundBase;
+
+namespace EShooterEffectType
+{
+	enum Type
+	{
+		Emitter,
+		Decal,
+		Sound,
+		MAX,
+	};
+}
+
+//
+// Per world budget for cosmetic effects - NOT used on dedicated servers
+// Impact, explosion and one-shot sound requests go through here, so a big firefight
+// can't spawn more emitters/decals/sounds in a single frame than the client can afford
+//
+UCLASS()
+class UShooterEffectBudget : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterEffectBudget();
+
+	/** get budget of world owning given object */
+	static UShooterEffectBudget* Get(const UObject* WorldContextObject);
+
+	/**
+	* Check if impact should be shown at all. Accepted impacts are remembered,
+	* so near-duplicates inside the merge window are rejected.
+	*
+	* @param Location	Impact location.
+	*/
+	bool ShouldSpawnImpact(const FVector& Location);
+
+	/**
+	* Spawn emitter if it fits in this frame's budget and is visible enough for local viewers.
+	*
+	* @param EffectRadius	Approximate radius of effect, used for screen size culling.
+	*/
+	UParticleSystemComponent* SpawnEmitterAtLocation(UParticleSystem* EmitterTemplate, const FVector& Location, const FRotator& Rotation, float EffectRadius);
+
+	/** spawn decal if it fits in this frame's budget, oldest decal is recycled when over the concurrent limit; placed in world when AttachToComponent is NULL */
+	UDecalComponent* SpawnDecalAttached(UMaterialInterface* DecalMaterial, const FVector& DecalSize, USceneComponent* AttachToComponent, FName AttachPointName, const FVector& Location, const FRotator& Rotation, float LifeSpan);
+
+	/** play sound if it fits in this frame's budget and is audible for local listeners */
+	void PlaySoundAtLocation(USoundBase* Sound, const FVector& Location);
+
+protected:
+
+	/** impact accepted recently, used for merging near-duplicates */
+	struct FRecentImpact
+	{
+		FVector Location;
+		float Time;
+	};
+
+	/** impacts accepted inside merge window */
+	TArray<FRecentImpact> RecentImpacts;
+
+	/** decals spawned through budget, oldest first */
+	TArray<TWeakObjectPtr<UDecalComponent>> ActiveDecals;
+
+	/** frame counter used to reset per frame budget */
+	uint64 BudgetFrame;
+
+	/** effects spawned in current frame, per type */
+	int32 SpawnedThisFrame[EShooterEffectType::MAX];
+
+	/** take one effect from this frame's budget, returns false when it's used up */
+	bool ConsumeFrameBudget(EShooterEffectType::Type Type);
+
+	/** check if any local viewer is close enough to see effect of given size */
+	bool IsRelevantForLocalViewers(const FVector& Location, float EffectRadius, float MaxDistance) const;
+};
@@ -94,6 +94,10 @@ class AShooterImpactEffect : public AActor
 	UPROPERTY(BlueprintReadOnly, Category=Surface)
 	FHitResult SurfaceHit;
 
+	/** surface type of hit, used when physical material wasn't replicated with SurfaceHit */
+	UPROPERTY(BlueprintReadOnly, Category=Surface)
+	TEnumAsByte<EPhysicalSurface> SurfaceType;
+
 	/** spawn effect */
 	virtual void PostInitializeComponents() override;
 
@@ -25,6 +25,9 @@ class AShooterGameMode : public AGameMode
 
 	virtual void PreInitializeComponents() override;
 
+	/** cache spawn points before first player is restarted */
+	virtual void StartPlay() override;
+
 	/** Initialize the game. This is called before actors' PreInitializeComponents. */
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
@@ -46,6 +49,9 @@ class AShooterGameMode : public AGameMode
 	/** returns default pawn class for given controller */
 	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
 
+	/** reuse pawn from pawn pool when one is ready */
+	virtual APawn* SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform) override;
+
 	/** prevents friendly fire */
 	virtual float ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const;
 
@@ -70,9 +76,12 @@ class AShooterGameMode : public AGameMode
 	/** new player joins */
 	virtual void HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer) override;
 
-	/** hides the onscreen hud and restarts the map */
+	/** hides the onscreen hud and restarts the match, in place unless ShooterMatch.ResetInPlace is off */
 	virtual void RestartGame() override;
 
+	/** keep pooled pawns and pickups owned by pools out of level reset */
+	virtual bool ShouldReset_Implementation(AActor* ActorToReset) override;
+
 	/** Creates AIControllers for all bots */
 	void CreateBotControllers();
 
@@ -122,6 +131,42 @@ protected:
 
 	bool bAllowBots;		
 
+	/** restarts are queued instead of done right away, set while match is starting */
+	bool bQueueRespawns;
+
+	/** controllers waiting to be restarted by ProcessRespawnQueue */
+	TArray<TWeakObjectPtr<AController>> PendingRespawns;
+
+	/** starts assigned to queued controllers, no two controllers share one */
+	TMap<TWeakObjectPtr<AController>, TWeakObjectPtr<APlayerStart>> AssignedStarts;
+
+	/** time and frame spike of current mass respawn */
+	double RespawnBatchStartTime;
+	double RespawnBatchMaxFrameTime;
+	int32 RespawnBatchNumFrames;
+	int32 RespawnBatchNumPlayers;
+
+	/** when last match ended and how long its in place reset took, for between-round downtime */
+	double MatchEndTime;
+	double MatchResetDuration;
+
+	/** [server] start next match without server travel: park pawns, reset actors and go back to warmup */
+	void ResetMatch();
+
+	/** pick start for every queued controller in one pass */
+	void AssignRespawnStarts();
+
+	/** restart queued controllers until ShooterRespawn.Budget is spent, continues next frame */
+	void ProcessRespawnQueue();
+
+	/**
+	* Pick random start among safest preferred ones.
+	*
+	* @param Player			Controller to spawn.
+	* @param ExcludedStarts	Starts already taken by other players.
+	*/
+	APlayerStart* PickPlayerStart(AController* Player, const TSet<APlayerStart*>& ExcludedStarts);
+
 	/** spawning all bots for this game */
 	void StartBots();
 
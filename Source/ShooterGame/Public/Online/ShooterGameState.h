@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Weapons/ShooterProjectileStream.h"
 #include "ShooterGameState.generated.h"
 
 /** ranked PlayerState map, created from the GameState */
@@ -30,8 +31,51 @@ public:
 	UPROPERTY(Transient, Replicated)
 	bool bTimerPaused;
 
+	/** projectiles simulated by server, see UShooterProjectileManager */
+	UPROPERTY(Transient, Replicated)
+	FShooterProjectileStream ProjectileStream;
+
+	/** clear team scores and match time, for match restarted in place */
+	virtual void Reset() override;
+
+	/** player with score it is ranked by */
+	struct FRankedPlayer
+	{
+		TWeakObjectPtr<AShooterPlayerState> PlayerState;
+		int32 Score;
+	};
+
+	/** add player to ranking */
+	virtual void AddPlayerState(APlayerState* PlayerState) override;
+
+	/** remove player from ranking */
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
+
 	/** gets ranked PlayerState map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
 
+	/** get players of team sorted by score, best first */
+	const TArray<FRankedPlayer>& GetTeamRanking(int32 TeamIndex) const;
+
+	/** changes whenever any team ranking changes order or players, views rebuild only when it differs */
+	uint32 GetRankingVersion() const;
+
+	/** move player within ranking after score or team changed, called on server and clients */
+	void UpdatePlayerRank(AShooterPlayerState* PlayerState);
+
 	void RequestFinishAndExitToMainMenu();
+
+protected:
+
+	/** players of each team sorted by score, kept sorted as scores change */
+	TArray<TArray<FRankedPlayer>> TeamRankings;
+
+	/** team each ranked player is in */
+	TMap<TWeakObjectPtr<AShooterPlayerState>, int32> RankedTeams;
+
+	/** bumped on every ranking change */
+	uint32 RankingVersion;
+
+	/** take player out of its team ranking */
+	void RemoveFromRanking(AShooterPlayerState* PlayerState);
 };
@@ -24,6 +24,9 @@ class AShooterPlayerState : public APlayerState
 	virtual void RegisterPlayerWithSession(bool bWasFromInvite) override;
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** update rank of replicated score */
+	virtual void OnRep_Score() override;
+
 	// End APlayerState interface
 
 	/**
@@ -91,6 +94,9 @@ protected:
 	/** Set the mesh colors based on the current teamnum variable */
 	void UpdateTeamColors();
 
+	/** move player in game state ranking after score or team changed */
+	void UpdateRank();
+
 	/** team number */
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_TeamColor)
 	int32 TeamNumber;
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterSpawnPoints.generated.h"
+
+class APlayerStart;
+class AShooterCharacter;
+
+//
+// Per world cache of player starts - server only
+// Starts are gathered once when play starts. Occupancy checks use character grid, and each start keeps
+// danger from nearby living characters (per team), updated incrementally only for characters that moved.
+//
+UCLASS()
+class UShooterSpawnPoints : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterSpawnPoints();
+
+	/** get spawn points of world owning given object */
+	static UShooterSpawnPoints* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/** gather all player starts in world */
+	void CacheStarts();
+
+	/** get cached starts, gathers them on first use */
+	const TArray<APlayerStart*>& GetStarts();
+
+	/** get index of start in GetStarts(), INDEX_NONE if not cached */
+	int32 GetStartIndex(const APlayerStart* Start) const;
+
+	/**
+	* Check if character capsule placed at location would overlap any character.
+	*
+	* @param SpawnLocation	Location of spawned character.
+	* @param Radius			Capsule radius of spawned character.
+	* @param HalfHeight		Capsule half height of spawned character.
+	*/
+	bool IsOccupied(const FVector& SpawnLocation, float Radius, float HalfHeight) const;
+
+	/**
+	* Get how dangerous start is, sum of falloff from all living characters in ShooterSpawn.DangerRadius.
+	*
+	* @param StartIdx		Index in GetStarts().
+	* @param FriendlyTeam	Characters of this team are not dangerous, INDEX_NONE if everyone is enemy.
+	*/
+	float GetDanger(int32 StartIdx, int32 FriendlyTeam) const;
+
+	/** refresh danger of characters that moved, at most once per ShooterSpawn.DangerUpdateInterval */
+	void UpdateDanger();
+
+protected:
+
+	/** danger added by single character */
+	struct FDangerSource
+	{
+		FVector Location;
+		int32 Team;
+		uint32 UpdateId;
+
+		/** start index and danger added to it */
+		TArray<TPair<int32, float>> Contributions;
+	};
+
+	/** cached starts */
+	UPROPERTY(Transient)
+	TArray<APlayerStart*> Starts;
+
+	/** danger of all characters per start */
+	TArray<float> TotalDanger;
+
+	/** danger per team per start, [Team][Start] */
+	TArray<TArray<float>> TeamDanger;
+
+	/** index of each start */
+	TMap<const APlayerStart*, int32> StartIndices;
+
+	/** start indices by cell, cell size is danger radius */
+	TMap<FIntPoint, TArray<int32>> StartCells;
+
+	/** cell size starts were bucketed with */
+	float CellSize;
+
+	/** characters currently adding danger */
+	TMap<TWeakObjectPtr<AShooterCharacter>, FDangerSource> DangerSources;
+
+	/** game time of last danger update */
+	float LastDangerUpdateTime;
+
+	/** incremented with each danger update, to find characters that are gone */
+	uint32 DangerUpdateId;
+
+	/** starts were gathered */
+	bool bStartsCached;
+
+	/** add or remove danger of source from starts */
+	void ApplyDanger(FDangerSource& Source, bool bAdd);
+
+	/** get cell containing location */
+	FIntPoint GetCell(const FVector& Location) const;
+};
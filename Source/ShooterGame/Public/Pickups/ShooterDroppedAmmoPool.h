@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterDroppedAmmoPool.generated.h"
+
+class AShooterPickup_Ammo;
+
+//
+// Per world pool of ammo dropped by dead characters - server only
+// Drops close to an active one are merged into it, number of pickups is capped (oldest one is reused),
+// and pickups are recycled once picked up or expired, so actor count stays bounded in long matches
+//
+UCLASS()
+class UShooterDroppedAmmoPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get pool of world owning given object */
+	static UShooterDroppedAmmoPool* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/**
+	* Leave ammo as pickup, merged with nearby drop when possible.
+	*
+	* @param PickupClass	Class of dropped pickup.
+	* @param Location		Where to drop it.
+	* @param Rotation		Rotation of new pickup.
+	* @param Ammo			Number of bullets.
+	* @param AmmoPerClip	Clip size of weapon the ammo is for.
+	*/
+	void DropAmmo(TSubclassOf<AShooterPickup_Ammo> PickupClass, const FVector& Location, const FRotator& Rotation, int32 Ammo, int32 AmmoPerClip);
+
+	/** return all drops to pool, for match restarted in place */
+	void RecycleAllDrops();
+
+protected:
+
+	/** pickup spawned by pool */
+	struct FDroppedAmmo
+	{
+		TWeakObjectPtr<AShooterPickup_Ammo> Pickup;
+		int32 Ammo;
+		float ExpireTime;
+		bool bInUse;
+	};
+
+	/** all pickups spawned by pool */
+	TArray<FDroppedAmmo> Drops;
+
+	/** Handle for efficient management of RecycleDrops timer */
+	FTimerHandle TimerHandle_RecycleDrops;
+
+	/** return picked up and expired drops to pool */
+	void RecycleDrops();
+
+	/** find drop to reuse for new ammo, INDEX_NONE if new pickup can be spawned */
+	int32 FindReusableDrop(TSubclassOf<AShooterPickup_Ammo> PickupClass) const;
+};
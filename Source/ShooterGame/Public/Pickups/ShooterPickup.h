@@ -16,10 +16,31 @@ class AShooterPickup : public AActor
 	/** check if pawn can use this pickup */
 	virtual bool CanBePickedUp(class AShooterCharacter* TestPawn) const;
 
+	/** is it ready for interactions? */
+	bool IsActive() const;
+
+	/** type pickup is indexed by in UShooterPickupIndex */
+	virtual UClass* GetPickupType() const;
+
+	/** [server] move to location and enable, for pickups reused by pool */
+	void ActivatePickup(const FVector& Location, const FRotator& Rotation);
+
+	/** [server] hide and disable until activated again, channel goes dormant */
+	void DeactivatePickup();
+
+	/** [server] respawn right away, for match restarted in place */
+	virtual void Reset() override;
+
 protected:
 	/** initial setup */
 	virtual void BeginPlay() override;
 
+	/** remove from pickup index */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** [server] update entry in pickup index after availability or location changed */
+	void UpdatePickupIndex();
+
 private:
 	/** FX component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Effects)
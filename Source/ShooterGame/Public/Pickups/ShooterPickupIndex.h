@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPickupIndex.generated.h"
+
+class AShooterPickup;
+
+//
+// Per world spatial index of available pickups - server only
+// Pickups are bucketed by type (weapon class for ammo, pickup class otherwise), each bucket is a 2D grid
+// holding only active pickups. Pickups update their entry when picked up and respawned.
+//
+UCLASS()
+class UShooterPickupIndex : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get index of world owning given object */
+	static UShooterPickupIndex* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/** add, move or remove pickup depending on its location and availability */
+	void UpdatePickup(AShooterPickup* Pickup);
+
+	/** remove pickup from index */
+	void RemovePickup(AShooterPickup* Pickup);
+
+	/**
+	* Find closest active pickups, sorted by distance.
+	*
+	* @param Type		Pickup type, subclasses match too (see AShooterPickup::GetPickupType).
+	* @param Location	Search origin.
+	* @param Count		Max number of pickups to find.
+	* @param MaxRadius	Pickups further away are ignored.
+	* @param Predicate	Only pickups passing it are found, so farther usable ones aren't hidden by closer unusable ones.
+	* @param OutPickups	Found pickups, closest first.
+	*/
+	void FindNearest(UClass* Type, const FVector& Location, int32 Count, float MaxRadius, TFunctionRef<bool(AShooterPickup*)> Predicate, TArray<AShooterPickup*>& OutPickups) const;
+
+	/** find all active pickups of type in radius, unsorted */
+	void QueryRadius(UClass* Type, const FVector& Center, float Radius, TArray<AShooterPickup*>& OutPickups) const;
+
+protected:
+
+	/** active pickups of single type */
+	struct FPickupBucket
+	{
+		TMap<FIntPoint, TArray<AShooterPickup*>> Cells;
+		FIntPoint MinCell;
+		FIntPoint MaxCell;
+		int32 NumPickups;
+
+		FPickupBucket()
+			: MinCell(MAX_int32, MAX_int32)
+			, MaxCell(MIN_int32, MIN_int32)
+			, NumPickups(0)
+		{
+		}
+	};
+
+	/** where pickup is stored */
+	struct FIndexedPickup
+	{
+		UClass* Type;
+		FIntPoint Cell;
+	};
+
+	/** buckets by pickup type */
+	TMap<UClass*, FPickupBucket> Buckets;
+
+	/** active pickups in index */
+	TMap<AShooterPickup*, FIndexedPickup> IndexedPickups;
+
+	/** cell size all buckets were built with */
+	float CellSize;
+
+	/** get cell containing location */
+	FIntPoint GetCell(const FVector& Location) const;
+};
@@ -19,6 +19,9 @@ class AShooterPickup_Ammo : public AShooterPickup
 
 	bool IsForWeapon(UClass* WeaponClass);
 
+	/** ammo pickups are indexed by weapon type */
+	virtual UClass* GetPickupType() const override;
+
 	/** Set how many clips this pickup holds */
 	void SetAmmoClips(int32 NClips);
 
@@ -4,6 +4,8 @@
 
 #include "ShooterPickup_Ammo.h"
 #include "ShooterTypes.h"
+#include "ShooterAmmoState.h"
+#include "ShooterInventory.h"
 #include "ShooterCharacter.generated.h"
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterCharacterEquipWeapon, AShooterCharacter*, AShooterWeapon* /* new */);
@@ -248,6 +250,9 @@ class AShooterCharacter : public ACharacter
 	*/
 	class AShooterWeapon* GetInventoryWeapon(int32 index) const;
 
+	/** [client] inventory entries changed or weapon references got resolved */
+	void OnInventoryReplicated();
+
 	/** get weapon taget modifier speed	*/
 	UFUNCTION(BlueprintCallable, Category = "Game|Weapon")
 	float GetTargetingSpeedModifier() const;
@@ -293,6 +298,12 @@ class AShooterCharacter : public ACharacter
 
 	/** Update the team color of all player meshes. */
 	void UpdateTeamColorsAllMIDs();
+
+	/** [server] park pawn in pawn pool (hidden, no collision, no tick), or take it out with health, movement and appearance reset */
+	void SetPooled(bool bNewPooled);
+
+	/** check if pawn is parked in pawn pool */
+	bool IsPooled() const;
 private:
 
 	/** pawn mesh: 1st person view */
@@ -310,7 +321,11 @@ protected:
 
 	/** weapons in inventory */
 	UPROPERTY(Transient, Replicated)
-	TArray<class AShooterWeapon*> Inventory;
+	FShooterInventory Inventory;
+
+	/** ammo of inventory weapons, packed for owner */
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_AmmoState)
+	FShooterAmmoState AmmoState;
 
 	/** currently equipped weapon */
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_CurrentWeapon)
@@ -374,6 +389,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
 	USoundCue* RespawnSound;
 
+	/** pawn is parked in pawn pool */
+	uint8 bIsPooled : 1;
+
 	/** sound played when health is low */
 	UPROPERTY(EditDefaultsOnly, Category = Pawn)
 	USoundCue* LowHealthSound;
@@ -483,11 +501,15 @@ protected:
 	/** current weapon rep handler */
 	UFUNCTION()
 	void OnRep_CurrentWeapon(class AShooterWeapon* LastWeapon);
+
+	/** ammo state rep handler */
+	UFUNCTION()
+	void OnRep_AmmoState();
 	
 	/** [server] spawns default inventory */
 	void SpawnDefaultInventory();
 
-	/** [server] remove all weapons from inventory and destroy them */
+	/** [server] remove all weapons from inventory and return them to weapon pool */
 	void DestroyInventory();
 
 	/** equip weapon */
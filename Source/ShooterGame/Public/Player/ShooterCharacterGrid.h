@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterCharacterGrid.generated.h"
+
+class AShooterCharacter;
+
+//
+// Per world spatial hash of characters
+// Characters register themselves on spawn, cells are rebuilt lazily once per frame on first query
+//
+UCLASS()
+class UShooterCharacterGrid : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterCharacterGrid();
+
+	/** get grid of world owning given object */
+	static UShooterCharacterGrid* Get(const UObject* WorldContextObject);
+
+	/** add character to grid */
+	void RegisterCharacter(AShooterCharacter* Character);
+
+	/** remove character from grid */
+	void UnregisterCharacter(AShooterCharacter* Character);
+
+	/**
+	* Find characters with location inside sphere.
+	*
+	* @param Center			Center of sphere.
+	* @param Radius			Radius of sphere.
+	* @param OutCharacters	Characters found, in no particular order.
+	*/
+	void QueryRadius(const FVector& Center, float Radius, TArray<AShooterCharacter*>& OutCharacters);
+
+	/**
+	* Test characters in order of distance, until one passes. Characters further away are not tested at all.
+	*
+	* @param Location		Search origin.
+	* @param Predicate		Test of single character, can be expensive (e.g. trace).
+	* @param MaxRadius		Characters further away are ignored.
+	* @return Closest character that passed, NULL if none.
+	*/
+	AShooterCharacter* FindNearest(const FVector& Location, TFunctionRef<bool(AShooterCharacter*)> Predicate, float MaxRadius = MAX_FLT);
+
+protected:
+
+	/** all registered characters */
+	TArray<TWeakObjectPtr<AShooterCharacter>> Characters;
+
+	/** cell -> indices in Characters array */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** cell size used when cells were built */
+	float BuiltCellSize;
+
+	/** frame counter when cells were built */
+	uint64 BuiltFrame;
+
+	/** bounds of non empty cells */
+	FIntPoint BuiltMinCell;
+	FIntPoint BuiltMaxCell;
+
+	/** rebuild cells if characters could have moved since last query */
+	void UpdateCells();
+
+	/** get cell containing location */
+	FIntPoint GetCell(const FVector& Location) const;
+};
@@ -38,6 +38,9 @@ class UShooterCharacterMovement : public UCharacterMovementComponent
 	/** [Local] The character lean on the side (camera roll) of SideLeanAmount degrees */
 	void CharacterSideLean(float SideLeanAmount) const;
 
+	/** [Server] Refill jetpack, stop wall run and unfreeze, used when pooled pawn is respawned */
+	void ResetMovementState();
+
 	
 	//// TELEPORT ////
 	
@@ -47,6 +50,12 @@ class UShooterCharacterMovement : public UCharacterMovementComponent
 	/** Teleport character forward of "distance" units */
 	void DoTeleport();
 
+	/** [Server] Teleport in given direction instead of forward, used by bots */
+	void DoTeleportInDirection(const FVector& Direction);
+
+	/** Direction of pending teleport, zero to use forward vector */
+	FVector TeleportDirection;
+
 	/** Character teleport distance */
 	UPROPERTY(EditDefaultsOnly, Category = "Character Movement: Teleport")
 	float TeleportDistance;
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/NetSerialization.h"
+#include "ShooterInventory.generated.h"
+
+class AShooterCharacter;
+class AShooterWeapon;
+struct FShooterInventory;
+
+/** single weapon in character's inventory */
+USTRUCT()
+struct FShooterInventoryEntry : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	AShooterWeapon* Weapon;
+
+	FShooterInventoryEntry()
+		: Weapon(NULL)
+	{
+	}
+};
+
+/**
+ * Weapons owned by character, replicated as delta: adding or removing weapon sends only that entry.
+ * Order matches server on all clients, entries are kept sorted by replication id.
+ */
+USTRUCT()
+struct FShooterInventory : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TArray<FShooterInventoryEntry> Items;
+
+	/** character owning inventory */
+	UPROPERTY(NotReplicated)
+	AShooterCharacter* Owner;
+
+	FShooterInventory()
+		: Owner(NULL)
+	{
+	}
+
+	int32 Num() const
+	{
+		return Items.Num();
+	}
+
+	AShooterWeapon* operator[](int32 Index) const
+	{
+		return Items[Index].Weapon;
+	}
+
+	/** get index of weapon, INDEX_NONE if it's not in inventory */
+	int32 IndexOf(const AShooterWeapon* Weapon) const;
+
+	/** [server] add weapon, if it's not in inventory yet */
+	void Add(AShooterWeapon* Weapon);
+
+	/** [server] remove weapon, keeping order of others */
+	void Remove(AShooterWeapon* Weapon);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterInventory> : public TStructOpsTypeTraitsBase2<FShooterInventory>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPawnPool.generated.h"
+
+class AShooterCharacter;
+
+//
+// Per world pool of character pawns - server only
+// Pawns are spawned ahead of time a few per frame, parked hidden and not replicated, so restarting
+// a player only moves a pawn and resets its state. Alive pawns left behind by players are parked again.
+//
+UCLASS()
+class UShooterPawnPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get pool of world owning given object */
+	static UShooterPawnPool* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/**
+	* Keep given number of pawns of class ready, they are spawned over next frames.
+	*
+	* @param PawnClass		Class of pooled pawns.
+	* @param NumPawns		Number of pawns to keep parked.
+	*/
+	void Prewarm(TSubclassOf<AShooterCharacter> PawnClass, int32 NumPawns);
+
+	/** take parked pawn of class out of pool and place it, NULL if none is ready */
+	AShooterCharacter* AcquirePawn(TSubclassOf<AShooterCharacter> PawnClass, const FTransform& SpawnTransform);
+
+	/** park unpossessed alive pawn for reuse */
+	void ReleasePawn(AShooterCharacter* Pawn);
+
+protected:
+
+	/** parked pawns of single class */
+	struct FPawnBucket
+	{
+		TArray<TWeakObjectPtr<AShooterCharacter>> FreePawns;
+		int32 NumWanted;
+	};
+
+	/** buckets by pawn class */
+	TMap<UClass*, FPawnBucket> Buckets;
+
+	/** Handle for efficient management of SpawnPrewarmedPawns timer */
+	FTimerHandle TimerHandle_SpawnPrewarmedPawns;
+
+	/** spawn up to ShooterPawnPool.SpawnsPerFrame pawns missing in buckets, keeps ticking until all are full */
+	void SpawnPrewarmedPawns();
+};
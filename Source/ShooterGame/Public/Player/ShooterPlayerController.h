@@ -33,6 +33,9 @@ public:
 	/** notify player about finished match */
 	virtual void ClientGameEnded_Implementation(class AActor* EndGameFocus, bool bIsWinner);
 
+	/** match restarted in place, clear end of match screen */
+	virtual void ClientReset_Implementation() override;
+
 	/** Notifies clients to send the end-of-round event */
 	UFUNCTION(reliable, client)
 	void ClientSendRoundEndEvent(bool bIsWinner, int32 ExpendedTimeInSeconds);
@@ -270,6 +273,9 @@ public:
 	/** respawn after dying */
 	virtual void UnFreeze() override;
 
+	/** return alive pawn to pawn pool instead of destroying it */
+	virtual void PawnLeavingGame() override;
+
 	/** sets up input */
 	virtual void SetupInputComponent() override;
 
@@ -18,5 +18,36 @@ public:
 	 * 	All regular engine handling, plus update ShooterKing state appropriately.
 	 */
 	virtual void HandleNetworkFailure(UWorld *World, UNetDriver *NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString) override;
+
+	/**
+	 * 	Load map, into its own copy of map package for extra matches. Starts extra matches after first map on dedicated server.
+	 */
+	virtual bool LoadMap(FWorldContext& WorldContext, FURL URL, class UPendingNetGame* Pending, FString& Error) override;
+
+	/** check if world hosts one of matches started by -ExtraMatches= */
+	static bool IsExtraMatchWorld(UWorld* World);
+
+protected:
+
+	/** number of matches hosted next to main one, each with own world, port and net driver */
+	int32 NumExtraMatches;
+
+	/** port offset between matches */
+	int32 MatchPortStep;
+
+	/** world contexts of extra matches */
+	TArray<FName> ExtraMatchContexts;
+
+	/** counter for unique map package names */
+	int32 NumInstancedMaps;
+
+	/** source map package of each instanced map package */
+	TMap<FString, FString> InstancedMapSources;
+
+	/** create world context for each extra match and load main map into it */
+	void StartExtraMatches(FWorldContext& MainContext, const FURL& MainURL);
+
+	/** load copy of map package under unique name, assets referenced by map stay shared */
+	FString InstanceMapPackage(const FString& MapName);
 };
 
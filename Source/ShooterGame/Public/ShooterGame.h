@@ -21,6 +21,8 @@ class UBehaviorTreeComponent;
 DECLARE_LOG_CATEGORY_EXTERN(LogShooter, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogShooterWeapon, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("ShooterGame"), STATGROUP_ShooterGame, STATCAT_Advanced);
+
 /** when you modify this, please note that this information can be saved with instances
  * also DefaultEngine.ini [/Script/Engine.CollisionProfile] should match with this list **/
 #define COLLISION_WEAPON		ECC_GameTraceChannel1
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "GauntletTestController.h"
+#include "ShooterTestControllerBotBenchmark.generated.h"
+
+// Measures server frame time with bots fighting, meant to be launched on game map with ?Bots=N (e.g. 32, 64, 128)
+// Warmup and sample length can be changed with -BotBenchmarkWarmup=<secs> and -BotBenchmarkDuration=<secs>
+// -BotBenchmarkKillInterval=<secs> kills all bots periodically while sampling, to measure mass death (ragdolls, respawns)
+UCLASS()
+class UShooterTestControllerBotBenchmark : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	// Seconds of match before sampling starts
+	float WarmupTime;
+
+	// Seconds of sampling
+	float SampleDuration;
+
+	// Seconds between killing all bots, 0 to let them fight
+	float KillInterval;
+	float TimeSinceKill;
+	int32 NumKills;
+
+	// Collected samples
+	float SampledTime;
+	int32 SampledFrames;
+	float MaxFrameTime;
+};
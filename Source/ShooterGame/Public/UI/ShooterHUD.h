@@ -21,6 +21,32 @@ struct FHitData
 	}
 };
 
+struct FHUDText
+{
+	/** Value the string was made from, MIN_int32 if set from string. */
+	int32 Value;
+
+	/** Displayed string. */
+	FString String;
+
+	/** Text drawn, rebuilt only when string changes. */
+	FText Text;
+
+	/** Unscaled size of text in Font. */
+	FVector2D Size;
+
+	/** Font text was measured with. */
+	UFont* Font;
+
+	/** Initialise defaults. */
+	FHUDText()
+		: Value(MIN_int32)
+		, Size(FVector2D::ZeroVector)
+		, Font(NULL)
+	{
+	}
+};
+
 struct FDeathMessage
 {
 	/** Name of player scoring kill. */
@@ -29,6 +55,10 @@ struct FDeathMessage
 	/** Name of killed player. */
 	FString VictimDesc;
 
+	/** Killer and victim text, measured once while message is shown. */
+	FHUDText KillerText;
+	FHUDText VictimText;
+
 	/** Killer is local player. */
 	uint8 bKillerIsOwner : 1;
 	
@@ -311,6 +341,25 @@ protected:
 	/** Array of information strings to render (Waiting to respawn etc) */
 	TArray<FCanvasTextItem> InfoItems;
 
+	/** Unscaled size of each info item. */
+	TArray<FVector2D> InfoItemSizes;
+
+	/** Retained text of HUD elements, only rebuilt and measured when their value changes. */
+	FHUDText PrimaryClipAmmoText;
+	FHUDText PrimarySpareAmmoText;
+	FHUDText SecondaryAmmoText;
+	FHUDText TimerText;
+	FHUDText PlaceText;
+	FHUDText KillsLabelText;
+	FHUDText KillsText;
+	FHUDText JetpackLabelText;
+	FHUDText JetpackFuelText;
+	FHUDText KilledText;
+	FHUDText CenteredKillText;
+	FHUDText WarmupText;
+	FHUDText RespawnText;
+	FHUDText NoAmmoText;
+
 	/** Called every time game is started. */
 	virtual void PostInitializeComponents() override;
 
@@ -362,6 +411,22 @@ protected:
 	/** Temporary helper for drawing text-in-a-box. */
 	void DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor);
 
+	/** 
+	 * Update retained text, rebuilding its text and size only when string or font changed.
+	 *
+	 * @param	HUDText	The text to update.
+	 * @param	String	The string to display.
+	 * @param	Font	Font the text is drawn with.
+	 * @return	The updated text.
+	 */
+	const FHUDText& UpdateHUDText(FHUDText& HUDText, const FString& String, UFont* Font);
+
+	/** Update retained text from localized text, remeasured when its display string changes. */
+	const FHUDText& UpdateHUDText(FHUDText& HUDText, const FText& Text, UFont* Font);
+
+	/** Update retained text showing number, string is only made when value changed. */
+	const FHUDText& UpdateHUDText(FHUDText& HUDText, int32 Value, UFont* Font);
+
 	/** helper for getting uv coords in normalized top,left, bottom, right format */
 	void MakeUV(FCanvasIcon& Icon, FVector2D& UV0, FVector2D& UV1, uint16 U, uint16 V, uint16 UL, uint16 VL);
 
@@ -376,8 +441,9 @@ protected:
 	 * Add information string that will be displayed on the hud. They are added as required and rendered together to prevent overlaps 
 	 * 
 	 * @param InInfoString	InInfoString
+	 * @param InfoText		Retained text of item, used for its size
 	*/
-	void AddMatchInfoString(const FCanvasTextItem InfoItem);
+	void AddMatchInfoString(const FCanvasTextItem InfoItem, const FHUDText& InfoText);
 
 	/*
 	* Render the info messages.
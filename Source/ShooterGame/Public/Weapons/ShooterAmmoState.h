@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/NetSerialization.h"
+#include "ShooterAmmoState.generated.h"
+
+struct FShooterInventory;
+
+/** ammo of single inventory weapon */
+USTRUCT()
+struct FShooterAmmoSlot
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** total ammo */
+	UPROPERTY()
+	int32 Ammo;
+
+	/** ammo inside clip */
+	UPROPERTY()
+	int32 AmmoInClip;
+
+	/** [server] bumped on every change, decides which slots are sent. [client] bumped on every received change */
+	UPROPERTY(NotReplicated)
+	uint32 Version;
+
+	FShooterAmmoSlot()
+		: Ammo(0)
+		, AmmoInClip(0)
+		, Version(0)
+	{
+	}
+};
+
+/**
+ * Ammo of all inventory weapons, replicated to owner only.
+ * Slots are indexed as owner's inventory, only slots changed since last acked state are sent, as packed ints.
+ */
+USTRUCT()
+struct FShooterAmmoState
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** max inventory size that can be replicated */
+	static const int32 MaxSlots = 15;
+
+	UPROPERTY()
+	TArray<FShooterAmmoSlot> Slots;
+
+	/** [server] copy ammo from inventory weapons */
+	void Update(const FShooterInventory& Inventory);
+
+	/** [client] push received changes to inventory weapons, and all ammo to newly added ones */
+	void Apply(const FShooterInventory& Inventory);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+private:
+
+	/** [client] weapon and slot version last pushed to each slot, so predicted ammo isn't overwritten with old values */
+	TArray<TWeakObjectPtr<class AShooterWeapon>> AppliedWeapons;
+	TArray<uint32> AppliedVersions;
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterAmmoState> : public TStructOpsTypeTraitsBase2<FShooterAmmoState>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
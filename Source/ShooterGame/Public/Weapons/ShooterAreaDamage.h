@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterAreaDamage.generated.h"
+
+class AShooterCharacter;
+
+//
+// Per world radial damage - server only
+// Affected characters come from UShooterCharacterGrid, occlusion traces of all explosions
+// in a frame are issued as one async batch and damage is applied when they come back
+//
+UCLASS()
+class UShooterAreaDamage : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get area damage of world owning given object */
+	static UShooterAreaDamage* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/**
+	* Damage characters in radius, with linear falloff from origin. Characters occluded from origin are not affected.
+	*
+	* @param BaseDamage		Damage at origin.
+	* @param Origin			Center of explosion.
+	* @param Radius			Radius of explosion.
+	* @param DamageType		Type of damage, UShooterDamageType flags decide special effects.
+	* @param DamageCauser	Actor that caused damage, ignored by occlusion traces.
+	* @param InstigatedBy	Controller responsible for damage.
+	*/
+	void ApplyRadialDamage(float BaseDamage, const FVector& Origin, float Radius, TSubclassOf<UDamageType> DamageType, AActor* DamageCauser, AController* InstigatedBy);
+
+protected:
+
+	/** explosion waiting for occlusion traces */
+	struct FPendingExplosion
+	{
+		float BaseDamage;
+		FVector Origin;
+		float Radius;
+		TSubclassOf<UDamageType> DamageType;
+		TWeakObjectPtr<AActor> DamageCauser;
+		TWeakObjectPtr<AController> InstigatedBy;
+		int32 NumPendingTraces;
+	};
+
+	/** character waiting for occlusion trace */
+	struct FPendingVictim
+	{
+		int32 ExplosionIndex;
+		TWeakObjectPtr<AShooterCharacter> Character;
+	};
+
+	/** explosions with traces in flight, removed with their last trace so indices stay stable and slots are reused */
+	TSparseArray<FPendingExplosion> PendingExplosions;
+
+	/** characters with traces in flight, trace user data is index in this array */
+	TSparseArray<FPendingVictim> PendingVictims;
+
+	/** bound to all occlusion traces */
+	FTraceDelegate OcclusionTraceDelegate;
+
+	/** occlusion trace finished, damage character if it wasn't blocked */
+	void OnOcclusionTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** apply damage to single character */
+	void DamageCharacter(const FPendingExplosion& Explosion, AShooterCharacter* Character);
+};
@@ -21,6 +21,13 @@ class UShooterDamageType : public UDamageType
 	/** force feedback effect to play on a player killed by this damage type */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
 	UForceFeedbackEffect *KilledForceFeedback;
+
+	/** freezes hit character instead of dealing damage */
+	UPROPERTY(EditDefaultsOnly, Category=Effects)
+	uint32 bFreeze : 1;
+
+	/** check if given damage type freezes instead of dealing damage */
+	static bool IsFreeze(TSubclassOf<UDamageType> DamageTypeClass);
 };
 
 
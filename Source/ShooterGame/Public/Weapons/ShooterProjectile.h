@@ -9,7 +9,10 @@
 class UProjectileMovementComponent;
 class USphereComponent;
 
-// 
+//
+// Visual representation of projectile - NOT replicated to clients
+// Simulation and damage are handled by UShooterProjectileManager, which spawns these locally
+//
 UCLASS(Abstract, Blueprintable)
 class AShooterProjectile : public AActor
 {
@@ -21,9 +24,23 @@ class AShooterProjectile : public AActor
 	/** setup velocity */
 	void InitVelocity(FVector& ShootDirection);
 
-	/** handle hit */
-	UFUNCTION()
-	void OnImpact(const FHitResult& HitResult);
+	/** blend predicted projectile */
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** move to impact point and play explosion */
+	void Explode(const FHitResult& Impact);
+
+	/** [client] sweep predicted projectile against world, so it stops at walls until server confirms it */
+	void EnablePredictionCollision();
+
+	/** [client] predicted projectile was matched with server one, correct it over BlendTime */
+	void BlendToServer(const FVector& ServerLocation, const FVector& ServerDirection, float BlendTime);
+
+	/** speed of projectile */
+	float GetInitialSpeed() const;
+
+	/** radius used for collision sweeps */
+	float GetCollisionRadius() const;
 
 private:
 	/** movement component */
@@ -42,29 +59,21 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
 	TSubclassOf<class AShooterExplosionEffect> ExplosionTemplate;
 
-	/** controller that fired me (cache for damage calculations) */
-	TWeakObjectPtr<AController> MyController;
-
 	/** projectile data */
 	struct FProjectileWeaponData WeaponConfig;
 
 	/** did it explode? */
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_Exploded)
 	bool bExploded;
 
-	/** [client] explosion happened */
-	UFUNCTION()
-	void OnRep_Exploded();
+	/** remaining offset to server position of predicted projectile */
+	FVector PredictionError;
 
-	/** trigger explosion */
-	void Explode(const FHitResult& Impact);
+	/** time left to apply PredictionError */
+	float PredictionBlendTimeLeft;
 
 	/** shutdown projectile and prepare for destruction */
 	void DisableAndDestroy();
 
-	/** update velocity on client */
-	virtual void PostNetReceiveVelocity(const FVector& NewVelocity) override;
-
 protected:
 	/** Returns MovementComp subobject **/
 	FORCEINLINE UProjectileMovementComponent* GetMovementComp() const { return MovementComp; }
@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterWeapon_Projectile.h"
+#include "ShooterProjectileStream.h"
+#include "ShooterProjectileManager.generated.h"
+
+class AShooterProjectile;
+
+//
+// Per world projectile simulation
+// Server moves projectiles as plain data with batched async sweeps and replicates spawn/explode
+// through FShooterProjectileStream on game state. AShooterProjectile actors exist only for visuals.
+//
+UCLASS()
+class UShooterProjectileManager : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterProjectileManager();
+
+	/** get manager of world owning given object */
+	static UShooterProjectileManager* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+	/** [server] start simulating new projectile, returns false if it couldn't be spawned */
+	bool SpawnProjectile(AShooterWeapon_Projectile* Weapon, const FProjectileWeaponData& Config, const FVector& Origin, const FVector& ShootDir, uint16 PredictionId = 0);
+
+	/** [client] spawn visual right away, until server's projectile with same prediction id replicates */
+	void SpawnPredictedProjectile(AShooterWeapon_Projectile* Weapon, const FProjectileWeaponData& Config, const FVector& Origin, const FVector& ShootDir, uint16 PredictionId);
+
+	/** [client] server didn't spawn predicted projectile */
+	void RejectPredictedProjectile(APawn* Instigator, uint16 PredictionId);
+
+	/** [client] stream callbacks */
+	void OnProjectileAdded(const FShooterProjectileEvent& Event);
+	void OnProjectileChanged(const FShooterProjectileEvent& Event);
+	void OnProjectileRemoved(const FShooterProjectileEvent& Event);
+
+protected:
+
+	/** rarely accessed projectile data */
+	struct FProjectileParams
+	{
+		TWeakObjectPtr<AShooterWeapon_Projectile> Weapon;
+		TWeakObjectPtr<APawn> Instigator;
+		TWeakObjectPtr<AController> Controller;
+		TSubclassOf<UDamageType> DamageType;
+		int32 ExplosionDamage;
+		float ExplosionRadius;
+	};
+
+	/** simulated projectiles, all arrays share index */
+	TArray<int32> ProjectileIds;
+	TArray<FVector> Locations;
+	TArray<FVector> Velocities;
+	TArray<float> Radii;
+	TArray<float> ExpireTimes;
+	TArray<FProjectileParams> Params;
+
+	/** projectile id -> index in simulation arrays */
+	TMap<int32, int32> IdToIndex;
+
+	/** next id to assign */
+	int32 NextProjectileId;
+
+	/** visual actors of projectiles in flight */
+	TMap<int32, TWeakObjectPtr<AShooterProjectile>> Visuals;
+
+	/** [client] projectile fired locally, waiting for server */
+	struct FPredictedProjectile
+	{
+		TWeakObjectPtr<APawn> Instigator;
+		TWeakObjectPtr<AShooterProjectile> Visual;
+		uint16 PredictionId;
+		float ExpireTime;
+	};
+
+	/** [client] predicted projectiles not matched yet */
+	TArray<FPredictedProjectile> PredictedProjectiles;
+
+	/** [client] take over predicted visual matching server's projectile */
+	AShooterProjectile* ClaimPredictedVisual(const FShooterProjectileEvent& Event);
+
+	/** [client] destroy predictions server didn't confirm in time */
+	void ExpirePredictedProjectiles();
+
+	/** get location of projectile now, based on spawn data */
+	FVector GetEventLocation(const FShooterProjectileEvent& Event, float Speed) const;
+
+	/** bound to all projectile sweeps */
+	FTraceDelegate SweepDelegate;
+
+	/** [server] sweep from last tick finished */
+	void OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** [server] apply damage, notify clients and stop simulation */
+	void ExplodeProjectile(int32 Index, const FHitResult& Impact);
+
+	/** [server] stop simulation, swaps last projectile into given index */
+	void RemoveProjectile(int32 Index);
+
+	/** [server] get replicated stream */
+	FShooterProjectileStream* GetStream() const;
+
+	/** spawn visual actor of projectile, moved forward by time it's been in flight */
+	AShooterProjectile* SpawnVisual(const FShooterProjectileEvent& Event, AShooterWeapon_Projectile* Weapon = NULL);
+
+	/** play explosion on visual actor */
+	void ExplodeVisual(const FShooterProjectileEvent& Event);
+};
@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/NetSerialization.h"
+#include "ShooterProjectileStream.generated.h"
+
+class AShooterProjectile;
+struct FShooterProjectileStream;
+
+/** single projectile in replicated stream: spawn data, and impact once it exploded */
+USTRUCT()
+struct FShooterProjectileEvent : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** id assigned by server's projectile manager */
+	UPROPERTY()
+	int32 ProjectileId;
+
+	/** class of visual actor */
+	UPROPERTY()
+	TSubclassOf<AShooterProjectile> ProjectileClass;
+
+	/** pawn that fired projectile */
+	UPROPERTY()
+	APawn* Instigator;
+
+	/** id of client side prediction made by instigator, 0 when not predicted */
+	UPROPERTY()
+	uint16 PredictionId;
+
+	/** spawn location */
+	UPROPERTY()
+	FVector_NetQuantize Origin;
+
+	/** flight direction */
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction;
+
+	/** server world time of spawn, used to catch up with projectiles already in flight */
+	UPROPERTY()
+	float SpawnTime;
+
+	/** did it explode? */
+	UPROPERTY()
+	uint8 bExploded : 1;
+
+	/** explosion location, valid only with bExploded */
+	UPROPERTY()
+	FVector_NetQuantize ImpactPoint;
+
+	/** explosion surface normal, valid only with bExploded */
+	UPROPERTY()
+	FVector_NetQuantizeNormal ImpactNormal;
+
+	/** [server] time when entry should be removed from stream */
+	UPROPERTY(NotReplicated)
+	float RemoveTime;
+
+	/** defaults */
+	FShooterProjectileEvent()
+		: ProjectileId(INDEX_NONE)
+		, ProjectileClass(NULL)
+		, Instigator(NULL)
+		, PredictionId(0)
+		, Origin(ForceInitToZero)
+		, Direction(ForceInitToZero)
+		, SpawnTime(0.0f)
+		, bExploded(false)
+		, ImpactPoint(ForceInitToZero)
+		, ImpactNormal(ForceInitToZero)
+		, RemoveTime(0.0f)
+	{
+	}
+
+	/** [client] spawn visual */
+	void PostReplicatedAdd(const FShooterProjectileStream& InArraySerializer);
+
+	/** [client] play explosion */
+	void PostReplicatedChange(const FShooterProjectileStream& InArraySerializer);
+
+	/** [client] remove visual */
+	void PreReplicatedRemove(const FShooterProjectileStream& InArraySerializer);
+};
+
+/** all projectiles in flight (and recently exploded) in world, replicated as delta */
+USTRUCT()
+struct FShooterProjectileStream : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TArray<FShooterProjectileEvent> Items;
+
+	/** actor replicating this stream */
+	UPROPERTY(NotReplicated)
+	AActor* Owner;
+
+	FShooterProjectileStream()
+		: Owner(NULL)
+	{
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FShooterProjectileEvent, FShooterProjectileStream>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterProjectileStream> : public TStructOpsTypeTraitsBase2<FShooterProjectileStream>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
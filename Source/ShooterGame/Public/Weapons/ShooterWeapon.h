@@ -108,8 +108,11 @@ class AShooterWeapon : public AActor
 	/** [server] add ammo */
 	void GiveAmmo(int AddAmount);
 
-	/** consume a bullet */
-	void UseAmmo();
+	/** [client] set ammo replicated through owner's ammo state */
+	void SetReplicatedAmmo(int32 NewAmmo, int32 NewAmmoInClip);
+
+	/** consume bullets */
+	void UseAmmo(int32 Count = 1);
 
 	/** query ammo type */
 	virtual EAmmoType GetAmmoType() const
@@ -135,6 +138,12 @@ class AShooterWeapon : public AActor
 	/** [server] weapon was removed from pawn's inventory */
 	virtual void OnLeaveInventory();
 
+	/** [server] restore state of freshly spawned weapon: initial ammo, no pending fire, reload or timers. Used when weapon is reused by UShooterWeaponPool */
+	void ResetForReuse();
+
+	/** [server] account for remote owner's shots fired until now, before its ammo or fire FX is used or replicated */
+	void UpdateServerBurst();
+
 	/** check if it's currently equipped */
 	bool IsEquipped() const;
 
@@ -252,10 +261,6 @@ class AShooterWeapon : public AActor
 	UPROPERTY(EditDefaultsOnly, Category=HUD)
 	bool bHideCrosshairWhileNotAiming;
 
-	/** Adjustment to handle frame rate affecting actual timer interval. */
-	UPROPERTY(Transient)
-	float TimerIntervalAdjustment;
-
 	/** Whether to allow automatic weapons to catch up with shorter refire cycles */
 	UPROPERTY(Config)
 	bool bAllowAutomaticWeaponCatchup = true;
@@ -396,18 +401,33 @@ protected:
 	/** time of last successful weapon fire */
 	float LastFireTime;
 
+	/** [server] how far behind server remote owner's fire timestamps are, burst is simulated with that delay */
+	float ServerFireLag;
+
+	/** [server] time of first shot in remote owner's burst */
+	float ServerBurstStartTime;
+
+	/** [server] shots already accounted for in remote owner's burst */
+	int32 ServerBurstShots;
+
+	/** [server] shots of remote owner's burst that used ammo */
+	int32 ServerBurstShotsCharged;
+
+	/** [server] shots of remote owner that used ammo but weren't claimed by fire request yet, negative when requests came first */
+	int32 ServerUnclaimedShots;
+
 	/** last time when this weapon was switched to */
 	float EquipStartedTime;
 
 	/** how much time weapon needs to be equipped */
 	float EquipDuration;
 
-	/** current total ammo */
-	UPROPERTY(Transient, Replicated)
+	/** current total ammo, replicated to owner through AShooterCharacter::AmmoState */
+	UPROPERTY(Transient)
 	int32 CurrentAmmo;
 
-	/** current ammo - inside clip */
-	UPROPERTY(Transient, Replicated)
+	/** current ammo - inside clip, replicated to owner through AShooterCharacter::AmmoState */
+	UPROPERTY(Transient)
 	int32 CurrentAmmoInClip;
 
 	/** burst counter, used for replicating fire events to remote clients */
@@ -430,10 +450,10 @@ protected:
 	// Input - server side
 
 	UFUNCTION(reliable, server, WithValidation)
-	void ServerStartFire();
+	void ServerStartFire(float ClientTimestamp);
 
 	UFUNCTION(reliable, server, WithValidation)
-	void ServerStopFire();
+	void ServerStopFire(float ClientTimestamp);
 
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerStartReload();
@@ -467,16 +487,33 @@ protected:
 	/** [local] weapon specific fire implementation */
 	virtual void FireWeapon() PURE_VIRTUAL(AShooterWeapon::FireWeapon,);
 
-	/** [server] fire & update ammo */
-	UFUNCTION(reliable, server, WithValidation)
-	void ServerHandleFiring();
-
-	/** [local + server] handle weapon refire, compensating for slack time if the timer can't sample fast enough */
+	/** [local] handle weapon refire, firing all shots that became due since last one if the timer can't sample fast enough */
 	void HandleReFiring();
 
-	/** [local + server] handle weapon fire */
+	/** [local] handle weapon fire */
 	void HandleFiring();
 
+	/** [server] account for remote owner's shots due until now, and wait until clip would run dry */
+	void HandleServerBurst();
+
+	/** [server] update ammo and burst counter for all remote owner's shots fired up to given time */
+	void SettleServerBurst(float UpToTime);
+
+	/** [server] give back ammo of shots settled after remote owner stopped firing */
+	void RefundServerBurst(float StopTime);
+
+	/** [server] number of remote owner's shots fired in burst up to given time */
+	int32 GetServerBurstShotsDue(float UpToTime) const;
+
+	/** [server] check if fire request (projectile) is backed by settled shot or weapon can still fire, and claim it */
+	bool ClaimServerShot();
+
+	/** [server] is weapon fired by remote client, which only sends burst start & stop? */
+	bool IsFiredByRemoteOwner() const;
+
+	/** [local] timestamp of fire input, sent to server */
+	float GetFireTimestamp() const;
+
 	/** [local + server] firing started */
 	virtual void OnBurstStarted();
 
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterWeaponPool.generated.h"
+
+class AShooterWeapon;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnShooterWeaponPooled, AShooterWeapon* /* weapon */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnShooterWeaponUnpooled, AShooterWeapon* /* weapon */);
+
+//
+// Per world pool of inventory weapons - server only
+// Weapons of dead characters go dormant instead of being destroyed, and are handed to the next
+// spawned character, so respawn doesn't spawn actors or open new channels on clients
+//
+UCLASS()
+class UShooterWeaponPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get pool of world owning given object */
+	static UShooterWeaponPool* Get(const UObject* WorldContextObject);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/** get weapon of given class with initial ammo, spawns new one if pool has none */
+	AShooterWeapon* AcquireWeapon(TSubclassOf<AShooterWeapon> WeaponClass);
+
+	/** weapon was removed from inventory, keep it for reuse */
+	void ReleaseWeapon(AShooterWeapon* Weapon);
+
+	/** Global notification when a weapon is parked in pool. Needed for replication graph. */
+	SHOOTERGAME_API static FOnShooterWeaponPooled NotifyWeaponPooled;
+
+	/** Global notification when a pooled weapon is handed out again. Needed for replication graph. */
+	SHOOTERGAME_API static FOnShooterWeaponUnpooled NotifyWeaponUnpooled;
+
+protected:
+
+	/** dormant weapons ready for reuse */
+	TArray<TWeakObjectPtr<AShooterWeapon>> FreeWeapons;
+};
@@ -20,6 +20,34 @@ struct FInstantHitInfo
 
 	UPROPERTY()
 	int32 RandomSeed;
+
+	/** impact location, valid only with bHasImpact */
+	UPROPERTY()
+	FVector_NetQuantize ImpactPoint;
+
+	/** impact normal, valid only with bHasImpact */
+	UPROPERTY()
+	FVector_NetQuantizeNormal ImpactNormal;
+
+	/** EPhysicalSurface of hit, so remote clients can pick effect without tracing */
+	UPROPERTY()
+	uint8 SurfaceType;
+
+	/** is this notify for hit or miss */
+	UPROPERTY()
+	uint8 bHasImpact : 1;
+
+	/** defaults */
+	FInstantHitInfo()
+		: Origin(ForceInitToZero)
+		, ReticleSpread(0.0f)
+		, RandomSeed(0)
+		, ImpactPoint(ForceInitToZero)
+		, ImpactNormal(ForceInitToZero)
+		, SurfaceType(SurfaceType_Default)
+		, bHasImpact(false)
+	{
+	}
 };
 
 USTRUCT()
@@ -154,10 +182,13 @@ protected:
 	void OnRep_HitNotify();
 
 	/** called in network play to do the cosmetic fx  */
-	void SimulateInstantHit(const FVector& Origin, int32 RandomSeed, float ReticleSpread);
+	void SimulateInstantHit(const FInstantHitInfo& HitInfo);
+
+	/** [server] fill hit notify for remote clients */
+	void SetHitNotify(const FHitResult& Impact, const FVector& Origin, int32 RandomSeed, float ReticleSpread);
 
 	/** spawn effects for impact */
-	void SpawnImpactEffects(const FHitResult& Impact);
+	void SpawnImpactEffects(const FHitResult& Impact, EPhysicalSurface SurfaceType);
 
 	/** spawn trail effect */
 	void SpawnTrailEffect(const FVector& EndPoint);
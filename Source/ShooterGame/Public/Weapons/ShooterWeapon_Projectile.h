@@ -68,7 +68,14 @@ protected:
 	/** [local] weapon specific fire implementation */
 	virtual void FireWeapon() override;
 
+	/** last id used for client side projectile prediction */
+	uint16 NextPredictionId;
+
 	/** spawn projectile on server */
 	UFUNCTION(reliable, server, WithValidation)
-	void ServerFireProjectile(FVector Origin, FVector_NetQuantizeNormal ShootDir);
+	void ServerFireProjectile(FVector Origin, FVector_NetQuantizeNormal ShootDir, uint16 PredictionId);
+
+	/** [client] server didn't spawn predicted projectile */
+	UFUNCTION(reliable, client)
+	void ClientRejectProjectile(uint16 PredictionId);
 };